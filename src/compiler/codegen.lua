@@ -987,7 +987,7 @@ function generate_bytecode(root, file)
 					emit(bc.call, 'jump', use_cache)
 
 					--Set cache and return
-					emit(bc.set_cache, get_cache_id(token.text))
+					emit(bc.set_cache, get_cache_id(token.text), token.tags and token.tags.cache_size)
 					emit(bc.pop_goto_index)
 
 					emit(bc.label, use_cache)
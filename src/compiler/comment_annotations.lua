@@ -194,6 +194,26 @@ local function process_comment_annotations(text, line, file)
 			NEXT_TAGS.elide = true
 		elseif i == '@PRIVATE' then
 			NEXT_TAGS.private = true
+		elseif i == '@CACHE_SIZE' then
+			local size_text = line:match('@[cC][aA][cC][hH][eE]_[sS][iI][zZ][eE]%s*(%S*)')
+			local size = tonumber(size_text)
+
+			--The C++ runtime stores the size in a 32-bit operand, and a size of 0 would mean "no limit given".
+			if not size or size < 1 or size > 2 ^ 31 - 1 or size % 1 ~= 0 then
+				local pos = text:find(line, 0, true)
+				local _, line_no = text:sub(0, pos):gsub('\n', '')
+				line_no = line_no + ln
+				local start, stop = line:find('@%S*%s*%S*')
+
+				parse_error(Span:new(
+					line_no,
+					start - 1,
+					line_no,
+					stop
+				), 'Cache size must be a whole number from 1 to ' .. math.floor(2 ^ 31 - 1) .. ' (got `' .. size_text .. '`).', file)
+			else
+				NEXT_TAGS.cache_size = size
+			end
 		elseif i == '@BRIEF' then
 			append_text(line, true)
 			local brief_text = process_text(line, true)
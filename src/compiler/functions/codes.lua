@@ -162,5 +162,11 @@ CALL_CODES = {
 	file_stat = uid(),
 	file_copy = uid(),
 	file_move = uid(),
+	cmd_spawn = uid(),
+	cmd_await = uid(),
+	cmd_await_any = uid(),
+	cmd_await_all = uid(),
+	cmd_lines = uid(),
+	cmd_pipe = uid(),
 	--[[/minify-delete]]
 }
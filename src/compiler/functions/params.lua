@@ -132,6 +132,12 @@ BUILTIN_FUNCS = {
 	file_stat = 1,
 	file_copy = 2,
 	file_move = 2,
+	cmd_spawn = -2,
+	cmd_await = 1,
+	cmd_await_any = 1,
+	cmd_await_all = 1,
+	cmd_lines = 1,
+	cmd_pipe = -2,
 	--[[/minify-delete]]
 }
 
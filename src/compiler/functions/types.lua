@@ -1202,6 +1202,60 @@ TYPESIG = {
 		category = 'files',
 		plasma = false,
 	},
+	cmd_spawn = {
+		valid = { { 'array', 'number' }, { 'string', 'number' } },
+		out = 'number',
+		params = { 'command', 'max_running' },
+		description =
+		'Start a command in the background, and return a handle for it. The command is either an array of the program and its arguments, or a string that is run by the shell. If max_running commands are already running (default: the number of CPU cores), wait for one of them to finish first.',
+		category = 'processes',
+		plasma = false,
+	},
+	cmd_await = {
+		valid = { { 'number' } },
+		out = 'object?',
+		params = { 'handle' },
+		description =
+		'Wait for a command started with `cmd_spawn()` to finish, and return its result: an object with "status", "stdout" and "stderr" keys. Each result can only be taken once; after that (or for an invalid handle), null is returned.',
+		category = 'processes',
+		plasma = false,
+	},
+	cmd_await_any = {
+		valid = { { 'array[number]' } },
+		out = 'number?',
+		params = { 'handles' },
+		description =
+		'Wait until any of the given commands has finished, and return its handle. Its result can then be taken with `cmd_await()`. If none of the handles are valid, null is returned.',
+		category = 'processes',
+		plasma = false,
+	},
+	cmd_await_all = {
+		valid = { { 'array[number]' } },
+		out = 'array[object?]',
+		params = { 'handles' },
+		description =
+		'Wait for all of the given commands to finish, and return an array of their results (see `cmd_await()`).',
+		category = 'processes',
+		plasma = false,
+	},
+	cmd_lines = {
+		valid = { { 'array' }, { 'string' } },
+		out = 'array[string]',
+		params = { 'command' },
+		description =
+		'Run a command, and return the lines of its stdout. The command is given the same way as for `cmd_spawn()`. When used directly as the list in a `for` loop, the lines are read one at a time as the loop runs, so the command\'s output never has to fit in memory.',
+		category = 'processes',
+		plasma = false,
+	},
+	cmd_pipe = {
+		valid = { { 'array', 'any' } },
+		out = 'object',
+		params = { 'commands', 'input' },
+		description =
+		'Run commands in a pipeline, with each one\'s stdout going to the next one\'s stdin, and return the result of the last command (see `cmd_await()`). Each command is given the same way as for `cmd_spawn()`. If input is given, it is written to the first command\'s stdin: a string as it is, or an array as one line per element. The data between commands never passes through the script, so this is much faster than passing the output of one `?` command to the next.',
+		category = 'processes',
+		plasma = false,
+	},
 	--[[/minify-delete]]
 
 	[TOK.add] = {
@@ -197,7 +197,9 @@ return {
 
 				local start, stop = kids[1].value, kids[2].value
 
-				if (stop - start) >= std.MAX_ARRAY_LEN then
+				--The C++ runtime stores ranges lazily, so loops, indexing and sum() over one aren't limited in size.
+				--Anything that needs all of its elements truncates it to 2^24 at run time, with a warning.
+				if (stop - start) >= std.MAX_ARRAY_LEN and TARGET ~= 'cpp' then
 					local msg = 'Attempt to create an array of ' ..
 						(stop - start + 1) .. ' elements (max is ' .. std.MAX_ARRAY_LEN .. '). Array truncated.'
 					parse_warning(token.span, msg, file)
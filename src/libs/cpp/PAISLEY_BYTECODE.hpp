@@ -2,10 +2,21 @@
 
 #include "value.hpp"
 #include "instruction.hpp"
+#include <cstdint>
 
-extern const std::vector<Instruction> INSTRUCTIONS;
-extern const std::vector<Value> CONSTANTS;
+// Moved into the VM at startup, since the loader rewrites instructions in place.
+extern std::vector<Instruction> INSTRUCTIONS;
+extern const std::vector<int> LINE_NUMBERS;
+
+// The program's constants, in the format read by ConstantPool (see constants.cpp).
+extern const char CONSTANT_DATA[];
+extern const uint32_t CONSTANT_OFFSETS[];
+extern const size_t CONSTANT_COUNT;
 extern const bool SANDBOXED;
 extern const std::string VERSION;
 
+// The program compiled to native code, or null if it only exists as bytecode.
+struct VirtualMachine;
+extern void (*const NATIVE_PROGRAM)(VirtualMachine &);
+
 using namespace std::string_literals;
@@ -1,6 +1,7 @@
 #include "actions.hpp"
 
 #include "actions/call.hpp"
+#include "actions/call_args.hpp"
 #include "actions/copy.hpp"
 #include "actions/delete_cache.hpp"
 #include "actions/delete_var.hpp"
@@ -8,6 +9,9 @@
 #include "actions/get_cache_else_jump.hpp"
 #include "actions/get_exception_type.hpp"
 #include "actions/get.hpp"
+#include "actions/jump_if_false.hpp"
+#include "actions/jump_if_nil.hpp"
+#include "actions/jump.hpp"
 #include "actions/pop_goto_index.hpp"
 #include "actions/pop_until_null.hpp"
 #include "actions/pop.hpp"
@@ -22,6 +26,18 @@
 #include "actions/swap.hpp"
 #include "actions/throw_exception.hpp"
 #include "actions/variable_insert.hpp"
+#include "actions/get_get.hpp"
+#include "actions/get_push.hpp"
+#include "actions/push_get.hpp"
+#include "actions/push_push.hpp"
+#include "actions/set_get.hpp"
+#include "actions/call_set.hpp"
+#include "actions/pop_jump_if_false.hpp"
+#include "actions/jump_if_nil_set.hpp"
+#include "actions/iter_begin.hpp"
+#include "actions/iter_next.hpp"
+#include "actions/iter_next_set.hpp"
+#include "actions/slice.hpp"
 
 const Operation OPERATIONS[] = {
 	call,
@@ -46,5 +62,21 @@ const Operation OPERATIONS[] = {
 	get_exception_type,
 	push_exception,
 	throw_exception,
+	jump,
+	jump_if_false,
+	jump_if_nil,
+	call_args,
+	get_get,
+	get_push,
+	push_get,
+	push_push,
+	set_get,
+	call_set,
+	pop_jump_if_false,
+	jump_if_nil_set,
+	iter_begin,
+	iter_next,
+	iter_next_set,
+	slice,
 };
 const size_t OPERATION_COUNT = sizeof(OPERATIONS) / sizeof(OPERATIONS[0]);
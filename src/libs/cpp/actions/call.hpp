@@ -1,5 +1,51 @@
 #pragma once
 
 #include "../virtual_machine.hpp"
+#include "../context.hpp"
+
+// Run a builtin function, from the current instruction.
+// If argc is negative, the function's params are imploded into an array on top of the stack.
+// Otherwise they are the top argc values on the stack.
+// `arg` is passed through to functions that take an extra numeric operand, like implode.
+inline void call_builtin(VirtualMachine &vm, Function function, int argc, int arg) noexcept
+{
+	Context context = {
+		vm.stack,
+		vm.variables,
+		vm.rng,
+		vm.instruction_index,
+		arg,
+		vm.line_numbers,
+		argc,
+	};
+
+	function(context);
+	if (vm.instruction_index != context.instruction_index)
+	{
+		vm.instruction_index = context.instruction_index - 1;
+	}
+}
+
+// Same as call_builtin(), for functions that read their argc params straight off the stack.
+// The params are replaced with the function's result.
+inline void call_builtin_args(VirtualMachine &vm, Function function, int argc) noexcept
+{
+	const size_t base = vm.stack.size() - argc;
+
+	// Make sure pushing the result can't move the arguments out from under the function.
+	vm.stack.reserve(vm.stack.size() + 1);
+
+	call_builtin(vm, function, argc, argc);
+
+	// Replace the arguments with the function's result.
+	if (vm.stack.size() > base + 1)
+	{
+		vm.stack[base] = std::move(vm.stack.back());
+		vm.stack.resize(base + 1);
+	}
+}
+
+// Run the builtin function given by the current instruction (see call_builtin).
+void call_function(VirtualMachine &vm, int argc, int arg) noexcept;
 
 void call(VirtualMachine &) noexcept;
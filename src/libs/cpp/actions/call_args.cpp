@@ -0,0 +1,10 @@
+#include "call_args.hpp"
+#include "call.hpp"
+
+void call_args(VirtualMachine &vm) noexcept
+{
+	const auto &instruction = vm.instructions[vm.instruction_index];
+
+	// The arguments are the top N values on the stack.
+	call_builtin_args(vm, vm.call_table[vm.instruction_index], instruction.operand1);
+}
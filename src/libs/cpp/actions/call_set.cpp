@@ -0,0 +1,11 @@
+#include "call_set.hpp"
+#include "call.hpp"
+
+void call_set(VirtualMachine &vm) noexcept
+{
+	// The second operand is the variable slot, not an argument for the function.
+	call_function(vm, -1, 0);
+
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.variables.set(instruction.operand1, vm.stack.pop());
+}
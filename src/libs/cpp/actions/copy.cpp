@@ -4,7 +4,7 @@ void copy(VirtualMachine &vm) noexcept
 {
 	auto &instruction = vm.instructions[vm.instruction_index];
 
-	size_t index = vm.stack.size() - instruction.operand[0] - 1;
+	size_t index = vm.stack.size() - instruction.operand0 - 1;
 
 	if (index >= vm.stack.size())
 	{
@@ -14,3 +14,9 @@ void copy(VirtualMachine &vm) noexcept
 
 	vm.stack.push(vm.stack[index]);
 }
+
+void copy_unchecked(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.stack.push(vm.stack[vm.stack.size() - instruction.operand0 - 1]);
+}
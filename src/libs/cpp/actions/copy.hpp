@@ -3,3 +3,6 @@
 #include "../virtual_machine.hpp"
 
 void copy(VirtualMachine &) noexcept;
+
+// Same as copy(), but skips the stack depth check. Only for verified programs.
+void copy_unchecked(VirtualMachine &) noexcept;
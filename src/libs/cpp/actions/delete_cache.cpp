@@ -5,5 +5,9 @@ void delete_cache(VirtualMachine &vm) noexcept
 	// Delete the cache for the given subroutine
 	auto &instruction = vm.instructions[vm.instruction_index];
 
-	vm.cache.erase(instruction.operand[0]);
+	auto cache = vm.cache.find(instruction.operand0);
+	if (cache != vm.cache.end())
+	{
+		cache->second.clear();
+	}
 }
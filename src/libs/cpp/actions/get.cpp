@@ -1,13 +1,10 @@
 #include "get.hpp"
 
-void get(VirtualMachine &vm) noexcept
+void push_special_variable(VirtualMachine &vm, int slot) noexcept
 {
-	auto &instruction = vm.instructions[vm.instruction_index];
-
-	const auto &var_name = vm.get_const(instruction.operand[0]).to_string();
-
-	if (var_name == "@")
+	switch (slot)
 	{
+	case VAR_PARAMS:
 		if (!vm.return_indices.empty())
 		{
 			// If inside a subroutine, get all subroutine arguments
@@ -18,32 +15,26 @@ void get(VirtualMachine &vm) noexcept
 			// Otherwise, get command-line arguments
 			vm.stack.push(vm.argv);
 		}
-		return;
-	}
-	else if (var_name == "$")
-	{
+		break;
+
+	case VAR_COMMANDS:
 		// Get all valid commands
 		exit(123);
-	}
-	else if (var_name == "_VARS")
-	{
+
+	case VAR_VARS:
 		// Get all variables
-		vm.stack.push(vm.variables);
-		return;
-	}
-	else if (var_name == "_VERSION")
-	{
+		vm.stack.push(vm.variables.to_object());
+		break;
+
+	case VAR_VERSION:
 		// Get version string
 		vm.stack.push(vm.version);
-		return;
+		break;
 	}
+}
 
-	if (vm.variables.find(var_name) == vm.variables.end())
-	{
-		vm.stack.push(Null());
-	}
-	else
-	{
-		vm.stack.push(vm.variables[var_name]);
-	}
+void get(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	push_variable(vm, instruction.operand1);
 }
@@ -2,4 +2,19 @@
 
 #include "../virtual_machine.hpp"
 
+void push_special_variable(VirtualMachine &vm, int slot) noexcept;
+
+// Push the value of a variable slot, or of a special variable (see SpecialVariable).
+// Superinstructions do this a lot, so the common case is inlined.
+inline void push_variable(VirtualMachine &vm, int slot) noexcept
+{
+	if (slot >= 0)
+	{
+		vm.stack.push(vm.variables[slot]);
+		return;
+	}
+
+	push_special_variable(vm, slot);
+}
+
 void get(VirtualMachine &) noexcept;
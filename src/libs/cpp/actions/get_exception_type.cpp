@@ -2,6 +2,7 @@
 
 void get_exception_type(VirtualMachine &vm) noexcept
 {
-	auto exception = std::get<std::map<std::string, Value>>(vm.stack.back());
-	vm.stack.push(exception["type"]);
+	const auto &exception = std::get<Object>(vm.stack.back());
+	const auto it = exception.find("type");
+	vm.stack.push(it != exception.end() ? it->second : Null());
 }
@@ -0,0 +1,9 @@
+#include "get_get.hpp"
+#include "get.hpp"
+
+void get_get(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	push_variable(vm, instruction.operand0);
+	push_variable(vm, instruction.operand1);
+}
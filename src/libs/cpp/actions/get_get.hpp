@@ -0,0 +1,5 @@
+#pragma once
+
+#include "../virtual_machine.hpp"
+
+void get_get(VirtualMachine &) noexcept;
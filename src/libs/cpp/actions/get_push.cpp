@@ -0,0 +1,9 @@
+#include "get_push.hpp"
+#include "get.hpp"
+
+void get_push(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	push_variable(vm, instruction.operand0);
+	vm.stack.push(vm.const_lookup[instruction.operand1]);
+}
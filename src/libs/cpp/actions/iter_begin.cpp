@@ -0,0 +1,24 @@
+#include "iter_begin.hpp"
+
+void iter_begin(VirtualMachine &vm) noexcept
+{
+	// Replace the value being looped over with an iterator: the array and a cursor into it.
+	// Arrays are shared, not copied, and other values are converted the same way as explode would.
+	// A stream (see cmd_lines) is read a line at a time as the loop goes, unless something else
+	// also has hold of it, since then the lines have to stay around after the loop.
+	Value container = vm.stack.pop();
+	if (std::holds_alternative<Array>(container))
+	{
+		const auto &array = std::get<Array>(container);
+		if (array.lazy().is_stream() && !array.unique())
+		{
+			array.raw();
+		}
+		vm.stack.push_back(std::move(container));
+	}
+	else
+	{
+		vm.stack.push_back(Array(container.to_array()));
+	}
+	vm.stack.push_back(0.0);
+}
@@ -0,0 +1,16 @@
+#include "iter_next.hpp"
+
+void iter_next(VirtualMachine &vm) noexcept
+{
+	Value element;
+
+	// Push the next element, or jump out of the loop if there isn't one.
+	if (iterate(vm, element))
+	{
+		vm.stack.push_back(std::move(element));
+	}
+	else
+	{
+		vm.instruction_index = vm.instructions[vm.instruction_index].operand0 - 1;
+	}
+}
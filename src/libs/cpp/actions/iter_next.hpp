@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../virtual_machine.hpp"
+
+// Move the loop iterator on the top of the stack (see iter_begin) to its next element.
+// Returns false once the loop is done, in which case the iterator is popped.
+// As with an exploded array, a null element also ends the loop.
+// Ranges are read without filling them in, and streams a line at a time (see ArrayData).
+inline bool iterate(VirtualMachine &vm, Value &element) noexcept
+{
+	const size_t size = vm.stack.size();
+	if (size >= 2)
+	{
+		auto *cursor = std::get_if<double>(&vm.stack[size - 1]);
+		const auto *array = std::get_if<Array>(&vm.stack[size - 2]);
+
+		if (cursor && array && array->lazy().is_stream())
+		{
+			if (array->lazy().next_line(element))
+			{
+				*cursor += 1;
+				return true;
+			}
+		}
+		else if (cursor && array && *cursor < array->size())
+		{
+			element = array->raw().element(static_cast<size_t>(*cursor));
+			if (!element.is_null())
+			{
+				*cursor += 1;
+				return true;
+			}
+		}
+	}
+
+	vm.stack.pop();
+	vm.stack.pop();
+	return false;
+}
+
+void iter_next(VirtualMachine &) noexcept;
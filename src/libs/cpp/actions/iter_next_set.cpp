@@ -0,0 +1,18 @@
+#include "iter_next_set.hpp"
+#include "iter_next.hpp"
+
+void iter_next_set(VirtualMachine &vm) noexcept
+{
+	const auto &instruction = vm.instructions[vm.instruction_index];
+	Value element;
+
+	// Same as iter_next, but the element goes straight into a variable.
+	if (iterate(vm, element))
+	{
+		vm.variables.set(instruction.operand1, std::move(element));
+	}
+	else
+	{
+		vm.instruction_index = instruction.operand0 - 1;
+	}
+}
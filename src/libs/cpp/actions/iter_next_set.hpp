@@ -0,0 +1,5 @@
+#pragma once
+
+#include "../virtual_machine.hpp"
+
+void iter_next_set(VirtualMachine &) noexcept;
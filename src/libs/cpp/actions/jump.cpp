@@ -0,0 +1,7 @@
+#include "jump.hpp"
+
+void jump(VirtualMachine &vm) noexcept
+{
+	const auto &instruction = vm.instructions[vm.instruction_index];
+	vm.instruction_index = instruction.operand0 - 1;
+}
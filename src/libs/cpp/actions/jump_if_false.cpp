@@ -0,0 +1,11 @@
+#include "jump_if_false.hpp"
+
+void jump_if_false(VirtualMachine &vm) noexcept
+{
+	// Does not pop the stack; the compiler emits a pop on both branches.
+	if (!vm.stack.back().to_bool())
+	{
+		const auto &instruction = vm.instructions[vm.instruction_index];
+		vm.instruction_index = instruction.operand0 - 1;
+	}
+}
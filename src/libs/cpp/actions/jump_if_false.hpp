@@ -0,0 +1,5 @@
+#pragma once
+
+#include "../virtual_machine.hpp"
+
+void jump_if_false(VirtualMachine &) noexcept;
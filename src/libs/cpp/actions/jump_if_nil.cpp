@@ -0,0 +1,10 @@
+#include "jump_if_nil.hpp"
+
+void jump_if_nil(VirtualMachine &vm) noexcept
+{
+	if (vm.stack.back().is_null())
+	{
+		const auto &instruction = vm.instructions[vm.instruction_index];
+		vm.instruction_index = instruction.operand0 - 1;
+	}
+}
@@ -0,0 +1,16 @@
+#include "jump_if_nil_set.hpp"
+
+void jump_if_nil_set(VirtualMachine &vm) noexcept
+{
+	const auto &instruction = vm.instructions[vm.instruction_index];
+
+	// Same as jump_if_nil, but the value is popped into a variable if there's no jump.
+	if (vm.stack.back().is_null())
+	{
+		vm.instruction_index = instruction.operand0 - 1;
+	}
+	else
+	{
+		vm.variables.set(instruction.operand1, vm.stack.pop());
+	}
+}
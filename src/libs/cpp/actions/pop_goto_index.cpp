@@ -2,13 +2,14 @@
 
 void pop_goto_index(VirtualMachine &vm) noexcept
 {
+	const auto &instruction = vm.instructions[vm.instruction_index];
+
 	const auto info = vm.return_indices.back();
 	vm.return_indices.pop_back();
 
 	vm.instruction_index = info.index;
 
-	auto &instruction = vm.instructions[vm.instruction_index];
-	if (!instruction.operand[0])
+	if (!instruction.operand0)
 	{
 		// Put any subroutine return value in the "command return value" slot
 		vm.last_cmd_result = vm.stack.pop();
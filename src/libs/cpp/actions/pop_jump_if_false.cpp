@@ -0,0 +1,11 @@
+#include "pop_jump_if_false.hpp"
+
+void pop_jump_if_false(VirtualMachine &vm) noexcept
+{
+	// Unlike jump_if_false, this pops the condition on both branches.
+	if (!vm.stack.pop().to_bool())
+	{
+		const auto &instruction = vm.instructions[vm.instruction_index];
+		vm.instruction_index = instruction.operand0 - 1;
+	}
+}
@@ -16,7 +16,7 @@ void _pop_until_null(VirtualMachine &vm) noexcept
 
 void pop_until_null(VirtualMachine &vm) noexcept
 {
-	const auto p1 = vm.instructions[vm.instruction_index].operand[0];
+	const auto p1 = vm.instructions[vm.instruction_index].operand0;
 
 	// If p1 is positive, leave that many values on the stack
 	if (p1)
@@ -4,6 +4,12 @@ void push(VirtualMachine &vm) noexcept
 {
 	auto &instruction = vm.instructions[vm.instruction_index];
 
-	const auto &constant = vm.get_const(instruction.operand[0]);
+	const auto &constant = vm.get_const(instruction.operand0);
 	vm.stack.push(constant);
 }
+
+void push_unchecked(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.stack.push(vm.const_lookup[instruction.operand0]);
+}
@@ -3,3 +3,6 @@
 #include "../virtual_machine.hpp"
 
 void push(VirtualMachine &) noexcept;
+
+// Same as push(), but skips the constant index check. Only for verified programs.
+void push_unchecked(VirtualMachine &) noexcept;
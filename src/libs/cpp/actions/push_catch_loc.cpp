@@ -5,7 +5,7 @@ void push_catch_loc(VirtualMachine &vm) noexcept
 	auto &instruction = vm.instructions[vm.instruction_index];
 
 	const ExceptStackInfo info = {
-		(size_t)instruction.operand[0],
+		(size_t)instruction.operand0,
 		vm.stack.size(),
 		vm.return_indices.size(),
 	};
@@ -5,21 +5,23 @@ void push_exception(VirtualMachine &vm) noexcept
 	auto &instruction = vm.instructions[vm.instruction_index];
 	Value arg;
 
-	if (instruction.operand[1])
+	if (instruction.operand1)
 	{
 		arg = vm.stack.pop();
 	}
 	else
 	{
-		arg = vm.get_const(instruction.operand[0]);
+		arg = vm.get_const(instruction.operand0);
 	}
 
-	std::map<std::string, Value> err;
+	const int line = vm.line_number(vm.instruction_index);
+
+	ObjectData err;
 	err["message"] = vm.stack.pop();
-	err["stack"] = std::vector<Value>{instruction.line_no};
+	err["stack"] = std::vector<Value>{line};
 	err["type"] = arg;
 	err["file"] = "unknown";
-	err["line"] = instruction.line_no;
+	err["line"] = line;
 
 	vm.stack.push(err);
 }
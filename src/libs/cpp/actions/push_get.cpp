@@ -0,0 +1,9 @@
+#include "push_get.hpp"
+#include "get.hpp"
+
+void push_get(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.stack.push(vm.const_lookup[instruction.operand0]);
+	push_variable(vm, instruction.operand1);
+}
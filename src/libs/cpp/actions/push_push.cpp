@@ -0,0 +1,8 @@
+#include "push_push.hpp"
+
+void push_push(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.stack.push(vm.const_lookup[instruction.operand0]);
+	vm.stack.push(vm.const_lookup[instruction.operand1]);
+}
@@ -1,14 +1,18 @@
 #include "run_command.hpp"
 #include "replace.hpp"
+#include "process.hpp"
+#include "shell_utils.hpp"
 #include "push_exception.hpp"
 #include "throw_exception.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <ctime>
 #include <sys/types.h>
 #include <thread>
 #include <unistd.h>
+#include <unordered_map>
 
 int LAST_COMMAND_RESULT = 0;
 std::string LAST_COMMAND_STDOUT;
@@ -34,160 +38,300 @@ std::string escape_shell_arg(const std::string &arg)
 	return escaped;
 }
 
-void run_command(VirtualMachine &vm)
+// Split a command into the commands of a pipeline, and their redirects.
+// Pipes and redirects arrive as raw shell text (`|`, `<`, `<<<`, and `>` after the stream: "1" for `?>`,
+// "2" for `!>` or "" for `?!>`). Returns false if there's any other shell text, which needs a real shell.
+static bool parse_pipeline(const std::vector<std::string> &args, std::vector<PipelineStage> &stages)
 {
-	const auto &value = vm.stack.pop().to_string_array();
-	const auto &command = value[0];
+	const auto is_raw = [](const std::string &arg)
+	{ return arg[0] == RAW_SH_TEXT_SENTINEL; };
 
-	if (command == "print" || command == "stdout" || command == "stderr")
+	stages.emplace_back();
+	for (size_t i = 0; i < args.size(); ++i)
 	{
-		std::string msg;
-		for (size_t i = 1; i < value.size(); ++i)
+		auto &stage = stages.back();
+		if (!is_raw(args[i]))
 		{
-			if (i > 1)
+			stage.argv.push_back(args[i]);
+			continue;
+		}
+
+		const auto op = args[i].substr(1);
+		if (op == "|")
+		{
+			if (stage.argv.empty())
 			{
-				msg += " ";
+				return false;
 			}
-			msg += value[i];
+			stages.emplace_back();
+			continue;
 		}
 
-		if (command == "print")
+		// Output redirects are the stream followed by `>`.
+		const bool output = (op == "1" || op == "2" || op.empty()) &&
+							i + 1 < args.size() && is_raw(args[i + 1]) && args[i + 1].substr(1) == ">";
+		if (output)
 		{
-			msg += "\n";
+			++i;
+		}
+		else if (op != "<" && op != "<<<")
+		{
+			return false;
 		}
 
-		auto &stream = (command == "stderr") ? std::cerr : std::cout;
-		stream << msg << std::flush;
-
-		vm.last_cmd_result = Null();
-	}
-	else if (command == "stdin")
-	{
-		std::string line;
-		std::getline(std::cin, line);
-		vm.last_cmd_result = line;
-	}
-	else if (command == "error")
-	{
-		vm.last_cmd_result = Null();
+		// Every redirect is followed by its target.
+		if (++i >= args.size())
+		{
+			return false;
+		}
+		const auto &target = args[i];
 
-		std::string msg;
-		for (size_t i = 1; i < value.size(); ++i)
+		if (!output)
 		{
-			if (i > 1)
+			if (is_raw(target))
+			{
+				return false;
+			}
+			if (op == "<")
 			{
-				msg += " ";
+				stage.in_file = target;
+			}
+			else
+			{
+				// Like bash, a here-string ends with a line break.
+				stage.has_input = true;
+				stage.input = target + "\n";
 			}
-			msg += value[i];
 		}
-
-		vm.stack.push({msg, "exception"});
-		auto &instruction = vm.instructions[vm.instruction_index];
-		instruction.operand[1] = 1;
-
-		push_exception(vm);
-		throw_exception(vm);
-	}
-	else if (command == "time" || command == "systime" || command == "sysdate")
-	{
-		auto t = std::time(nullptr);
-		std::tm now = *std::localtime(&t);
-
-		if (command == "sysdate")
+		else if (is_raw(target))
+		{
+			// `!>?` or `?>!`
+			if (op == "2" && target.substr(1) == "&1")
+			{
+				stage.err_to_out = true;
+			}
+			else if (op == "1" && target.substr(1) == "&2")
+			{
+				stage.out_to_err = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		else if (op == "1")
 		{
-			// Output [day, month, year]
-			vm.last_cmd_result = {now.tm_mday, now.tm_mon + 1, now.tm_year + 1900};
+			stage.out_file = target;
+		}
+		else if (op == "2")
+		{
+			stage.err_file = target;
 		}
 		else
 		{
-			// Output seconds since midnight
-			vm.last_cmd_result = now.tm_hour * 3600 + now.tm_min * 60 + now.tm_sec;
+			stage.out_file = target;
+			stage.err_to_out = true;
 		}
 	}
-	else if (command == "sleep")
+
+	return std::all_of(stages.begin(), stages.end(), [](const PipelineStage &stage)
+					   { return !stage.argv.empty() && !(stage.out_to_err && stage.err_to_out); });
+}
+
+// Join a command's arguments with spaces.
+static std::string join_args(const std::vector<std::string> &value)
+{
+	std::string msg;
+	for (size_t i = 1; i < value.size(); ++i)
 	{
-		std::this_thread::sleep_for(std::chrono::milliseconds((int)(std::stod(value[1]) * 1000.0)));
-		vm.last_cmd_result = Null();
+		if (i > 1)
+		{
+			msg += " ";
+		}
+		msg += value[i];
 	}
-	else if (command == "clear")
+	return msg;
+}
+
+static void command_print(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	std::cout << join_args(value) + "\n" << std::flush;
+	vm.last_cmd_result = Null();
+}
+
+static void command_stdout(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	std::cout << join_args(value) << std::flush;
+	vm.last_cmd_result = Null();
+}
+
+static void command_stderr(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	std::cerr << join_args(value) << std::flush;
+	vm.last_cmd_result = Null();
+}
+
+static void command_stdin(VirtualMachine &vm, const std::vector<std::string> &)
+{
+	std::string line;
+	std::getline(std::cin, line);
+	vm.last_cmd_result = line;
+}
+
+static void command_error(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	vm.last_cmd_result = Null();
+
+	vm.stack.push({join_args(value), "exception"});
+	auto &instruction = vm.instructions[vm.instruction_index];
+	instruction.operand1 = 1;
+
+	push_exception(vm);
+	throw_exception(vm);
+}
+
+static void command_time(VirtualMachine &vm, const std::vector<std::string> &)
+{
+	// Output seconds since midnight
+	auto t = std::time(nullptr);
+	std::tm now = *std::localtime(&t);
+	vm.last_cmd_result = now.tm_hour * 3600 + now.tm_min * 60 + now.tm_sec;
+}
+
+static void command_sysdate(VirtualMachine &vm, const std::vector<std::string> &)
+{
+	// Output [day, month, year]
+	auto t = std::time(nullptr);
+	std::tm now = *std::localtime(&t);
+	vm.last_cmd_result = {now.tm_mday, now.tm_mon + 1, now.tm_year + 1900};
+}
+
+static void command_sleep(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds((int)(std::stod(value[1]) * 1000.0)));
+	vm.last_cmd_result = Null();
+}
+
+static void command_clear(VirtualMachine &vm, const std::vector<std::string> &)
+{
+	// Run clear command
+	std::cout << "\033[2J\033[1;1H";
+	vm.last_cmd_result = Null();
+}
+
+static void command_noop(VirtualMachine &vm, const std::vector<std::string> &)
+{
+	// No-op (results are calculated but discarded)
+	vm.last_cmd_result = Null();
+}
+
+// `!`, `?`, `?!` and `=`: run a program, and get its stderr, stdout, both, or its exit code.
+static void command_shell(VirtualMachine &vm, const std::vector<std::string> &value)
+{
+	const auto &command = value[0];
+	if (vm.sandboxed)
 	{
-		// Run clear command
-		std::cout << "\033[2J\033[1;1H";
-		vm.last_cmd_result = Null();
+		vm.error("Unknown command: " + command);
+		return;
 	}
-	else if (!vm.sandboxed && (command == "!" || command == "?" || command == "?!" || command == "="))
+
+	// If command is run with any parameters, treat them as a shell command to execute
+	if (value.size() > 1)
 	{
-		// If command is run with any parameters, treat them as a shell command to execute
-		if (value.size() > 1)
+		// Commands are run directly, including pipelines and redirects. Only other shell text
+		// (which the compiler doesn't currently produce) still has to go through the shell.
+		const std::vector<std::string> args(value.begin() + 1, value.end());
+		std::vector<PipelineStage> stages;
+		if (!parse_pipeline(args, stages))
 		{
-			LAST_COMMAND_RESULT = 0;
-			LAST_COMMAND_STDOUT.clear();
-			LAST_COMMAND_STDERR.clear();
-
-			// Get the arguments
-			std::string args;
-			for (size_t i = 1; i < value.size(); ++i)
+			// If arg starts with RAW_SH_TEXT_SENTINEL, pass it to the shell as-is,
+			// and don't escape special characters.
+			std::string text;
+			for (const auto &arg : args)
 			{
-				// If arg starts with RAW_SH_TEXT_SENTINEL, treat it as a raw shell command,
-				// and don't escape special characters.
-				if (value[i][0] == RAW_SH_TEXT_SENTINEL)
+				if (arg[0] == RAW_SH_TEXT_SENTINEL)
 				{
-					args += value[i].substr(1) + " ";
+					text += arg.substr(1) + " ";
 				}
 				else
 				{
-					args += "\"" + escape_shell_arg(value[i]) + "\" ";
-				}
-			}
-
-			char buffer[512];
-			FILE *in = popen(args.c_str(), "r");
-			if (in)
-			{
-				while (fgets(buffer, sizeof(buffer), in))
-				{
-					LAST_COMMAND_STDOUT += buffer;
+					text += "\"" + escape_shell_arg(arg) + "\" ";
 				}
-				LAST_COMMAND_RESULT = pclose(in);
 			}
 
-			if (command != "?!")
-			{
-				if (command != "?")
-				{
-					std::cout << LAST_COMMAND_STDOUT;
-				}
-				else if (command != "!")
-				{
-					std::cerr << LAST_COMMAND_STDERR;
-				}
-			}
+			stages.assign(1, PipelineStage());
+			stages[0].argv = {"/bin/sh", "-c", text};
 		}
 
-		if (command == "?")
-		{
-			vm.last_cmd_result = LAST_COMMAND_STDOUT;
-		}
-		else if (command == "!")
-		{
-			vm.last_cmd_result = LAST_COMMAND_STDERR;
-		}
-		else if (command == "?!")
+		// Whatever stream isn't being captured is shown as the command runs.
+		// Common utilities like `cat` and `sort` are run without starting a program at all.
+		const bool echo_out = command == "!" || command == "=";
+		const bool echo_err = command == "?" || command == "=";
+		ProcessResult result;
+		if (run_shell_utils(stages, result))
 		{
-			vm.last_cmd_result = LAST_COMMAND_STDOUT + LAST_COMMAND_STDERR;
+			if (echo_out)
+			{
+				std::cout << result.out << std::flush;
+			}
 		}
 		else
 		{
-			vm.last_cmd_result = LAST_COMMAND_RESULT;
+			result = run_pipeline(stages, echo_out, echo_err);
 		}
+
+		LAST_COMMAND_RESULT = result.status;
+		LAST_COMMAND_STDOUT = std::move(result.out);
+		LAST_COMMAND_STDERR = std::move(result.err);
+	}
+
+	if (command == "?")
+	{
+		vm.last_cmd_result = LAST_COMMAND_STDOUT;
+	}
+	else if (command == "!")
+	{
+		vm.last_cmd_result = LAST_COMMAND_STDERR;
 	}
-	else if (command == ".")
+	else if (command == "?!")
 	{
-		// No-op (results are calculated but discarded)
-		vm.last_cmd_result = Null();
+		vm.last_cmd_result = LAST_COMMAND_STDOUT + LAST_COMMAND_STDERR;
 	}
 	else
+	{
+		vm.last_cmd_result = LAST_COMMAND_RESULT;
+	}
+}
+
+// Every built-in command, by name.
+static const std::unordered_map<std::string, void (*)(VirtualMachine &, const std::vector<std::string> &)> COMMANDS = {
+	{"print", command_print},
+	{"stdout", command_stdout},
+	{"stderr", command_stderr},
+	{"stdin", command_stdin},
+	{"error", command_error},
+	{"time", command_time},
+	{"systime", command_time},
+	{"sysdate", command_sysdate},
+	{"sleep", command_sleep},
+	{"clear", command_clear},
+	{"!", command_shell},
+	{"?", command_shell},
+	{"?!", command_shell},
+	{"=", command_shell},
+	{".", command_noop},
+};
+
+void run_command(VirtualMachine &vm)
+{
+	const auto &value = vm.stack.pop().to_string_array();
+	const auto &command = value[0];
+
+	const auto handler = COMMANDS.find(command);
+	if (handler == COMMANDS.end())
 	{
 		vm.error("Unknown command: " + command);
+		return;
 	}
+	handler->second(vm, value);
 }
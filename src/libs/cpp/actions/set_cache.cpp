@@ -8,7 +8,14 @@ void set_cache(VirtualMachine &vm) noexcept
 	// Get the cache key
 	Value params = vm.return_indices.size() ? vm.return_indices.back().params : std::vector<Value>();
 
+	// The second operand is the subroutine's own size limit, if it has one.
+	auto &cache = vm.cache[instruction.operand0];
+	if (instruction.operand1 > 0)
+	{
+		cache.capacity = instruction.operand1;
+	}
+
 	// Set the cache value
-	vm.cache[instruction.operand[0]][params.pretty_print()] = vm.last_cmd_result;
+	cache.insert(params, vm.last_cmd_result);
 	vm.stack.push(vm.last_cmd_result);
 }
@@ -0,0 +1,9 @@
+#include "set_get.hpp"
+#include "get.hpp"
+
+void set_get(VirtualMachine &vm) noexcept
+{
+	auto &instruction = vm.instructions[vm.instruction_index];
+	vm.variables.set(instruction.operand0, vm.stack.pop());
+	push_variable(vm, instruction.operand1);
+}
@@ -0,0 +1,8 @@
+#include "slice.hpp"
+#include "call.hpp"
+#include "../functions/arrayindex.hpp"
+
+void slice(VirtualMachine &vm) noexcept
+{
+	call_builtin(vm, arrayindex_slice, 0, 0);
+}
@@ -9,5 +9,10 @@ void swap(VirtualMachine &vm) noexcept
 		return;
 	}
 
-	std::swap(vm.stack[vm.stack.size() - 1], vm.stack[vm.stack.size() - 2]);
+	vm.stack[vm.stack.size() - 1].swap(vm.stack[vm.stack.size() - 2]);
+}
+
+void swap_unchecked(VirtualMachine &vm) noexcept
+{
+	vm.stack[vm.stack.size() - 1].swap(vm.stack[vm.stack.size() - 2]);
 }
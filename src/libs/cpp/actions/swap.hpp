@@ -3,3 +3,6 @@
 #include "../virtual_machine.hpp"
 
 void swap(VirtualMachine &) noexcept;
+
+// Same as swap(), but skips the stack depth check. Only for verified programs.
+void swap_unchecked(VirtualMachine &) noexcept;
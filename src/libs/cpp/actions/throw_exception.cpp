@@ -4,13 +4,13 @@
 
 void throw_exception(VirtualMachine &vm) noexcept
 {
-	auto err = std::get<std::map<std::string, Value>>(vm.stack.back());
-	auto &err_stack = std::get<std::vector<Value>>(err["stack"]);
+	auto err = std::get<Object>(vm.stack.back()).get();
+	auto &err_stack = std::get<Array>(err["stack"]).mut();
 
 	if (vm.except_stack.empty())
 	{
 		// If exception is not caught, end the program immediately and output the error.
-		auto message = std::get<std::string>(err["message"]);
+		auto message = err["message"].to_string();
 		auto line = (int)std::get<double>(err["line"]);
 		std::cerr << "ERROR: [line " << line << "] " << message << std::endl;
 		std::cerr << "Error not caught, program terminated." << std::endl;
@@ -29,8 +29,8 @@ void throw_exception(VirtualMachine &vm) noexcept
 	{
 		auto retn = vm.return_indices.back();
 		vm.return_indices.pop_back();
-		auto line = vm.instructions[retn.index].line_no;
-		std::get<std::vector<Value>>(err["stack"]).push_back(line);
+		auto line = vm.line_number(retn.index);
+		err_stack.push_back(line);
 	}
 
 	vm.instruction_index = info.goto_index - 1;
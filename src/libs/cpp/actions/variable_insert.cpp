@@ -4,9 +4,9 @@ void update_subobject(Value &object, const Value &value, const std::vector<Value
 {
 	if (i == (long)indices.size() - 1)
 	{
-		if (std::holds_alternative<std::vector<Value>>(object))
+		if (std::holds_alternative<Array>(object))
 		{
-			auto &vec = std::get<std::vector<Value>>(object);
+			auto &vec = std::get<Array>(object).mut();
 			long n_ix = indices[i].to_number() - 1;
 			if (n_ix < 0)
 			{
@@ -19,15 +19,15 @@ void update_subobject(Value &object, const Value &value, const std::vector<Value
 			}
 			vec[n_ix] = value;
 		}
-		else if (std::holds_alternative<std::map<std::string, Value>>(object))
+		else if (std::holds_alternative<Object>(object))
 		{
-			auto &obj = std::get<std::map<std::string, Value>>(object);
+			auto &obj = std::get<Object>(object).mut();
 			auto s_ix = indices[i].to_string();
 			obj.insert_or_assign(s_ix, value);
 		}
-		else if (std::holds_alternative<std::string>(object))
+		else if (std::holds_alternative<String>(object))
 		{
-			auto &str = std::get<std::string>(object);
+			auto &str = std::get<String>(object).mut();
 			auto n_ix = indices[i].to_number() - 1;
 			if (n_ix < 0)
 			{
@@ -45,9 +45,9 @@ void update_subobject(Value &object, const Value &value, const std::vector<Value
 	}
 
 	// Not at the bottom level yet
-	if (std::holds_alternative<std::vector<Value>>(object))
+	if (std::holds_alternative<Array>(object))
 	{
-		auto &vec = std::get<std::vector<Value>>(object);
+		auto &vec = std::get<Array>(object).mut();
 		auto n_ix = indices[i].to_number() - 1;
 		if (n_ix < 0)
 		{
@@ -60,9 +60,9 @@ void update_subobject(Value &object, const Value &value, const std::vector<Value
 		}
 		update_subobject(vec[n_ix], value, indices, i + 1);
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(object))
+	else if (std::holds_alternative<Object>(object))
 	{
-		auto &obj = std::get<std::map<std::string, Value>>(object);
+		auto &obj = std::get<Object>(object).mut();
 		auto s_ix = indices[i].to_string();
 		if (obj.find(s_ix) == obj.end())
 		{
@@ -83,19 +83,21 @@ void variable_insert(VirtualMachine &vm) noexcept
 	auto value = vm.stack.pop();
 	auto ix = vm.stack.pop();
 
-	// This is guaranteed to be a string by the compiler
-	const auto var_name = std::get<std::string>(vm.stack.pop());
-	if (!vm.variables.has(var_name))
+	// This is guaranteed to be a string constant by the compiler
+	const String name = std::get<String>(vm.stack.pop());
+	const std::string &var_name = name;
+	const size_t slot = vm.variables.slot(name);
+	if (!vm.variables.has(slot))
 	{
 		// Variable doesn't exist, so we can't insert into it
 		vm.warn("Attempted to insert into non-existent variable '" + var_name + "'. Ignoring!");
 		return;
 	}
 
-	auto &var = vm.variables.get_ref(var_name);
+	auto &var = vm.variables.get_ref(slot);
 
 	// Only valid for arrays, objects, or strings
-	if (!std::holds_alternative<std::vector<Value>>(var) && !std::holds_alternative<std::map<std::string, Value>>(var) && !std::holds_alternative<std::string>(var))
+	if (!std::holds_alternative<Array>(var) && !std::holds_alternative<Object>(var) && !std::holds_alternative<String>(var))
 	{
 		vm.warn("Attempted to insert into non-iterable variable '" + var_name + "'. Ignoring!");
 		return;
@@ -104,13 +106,13 @@ void variable_insert(VirtualMachine &vm) noexcept
 	// If appending
 	if (ix.is_null())
 	{
-		if (std::holds_alternative<std::vector<Value>>(var))
+		if (std::holds_alternative<Array>(var))
 		{
-			std::get<std::vector<Value>>(var).push_back(value);
+			std::get<Array>(var).mut().push_back(value);
 		}
-		else if (std::holds_alternative<std::string>(var))
+		else if (std::holds_alternative<String>(var))
 		{
-			auto &str = std::get<std::string>(var);
+			auto &str = std::get<String>(var).mut();
 			str += value.to_string();
 		}
 		else
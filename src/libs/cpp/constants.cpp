@@ -0,0 +1,89 @@
+#include "constants.hpp"
+#include "intern.hpp"
+
+#include <cstdlib>
+
+// Constants are encoded as a type tag followed by the value:
+//   n          null
+//   t, f       true, false
+//   i <size>   integer, zigzag encoded (0, -1, 1, -2, ... become 0, 1, 2, 3, ...)
+//   d <text>   any other number, as text
+//   s <text>   string
+//   a <size> <value>...             array
+//   o <size> (<text> <value>)...    object
+// where sizes are unsigned LEB128 numbers, and text is a size followed by that many bytes.
+
+static size_t read_size(const char *&data) noexcept
+{
+	size_t result = 0;
+	for (int shift = 0;; shift += 7)
+	{
+		const auto byte = static_cast<unsigned char>(*data++);
+		result |= static_cast<size_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+		{
+			return result;
+		}
+	}
+}
+
+static std::string read_text(const char *&data)
+{
+	const size_t length = read_size(data);
+	std::string result(data, length);
+	data += length;
+	return result;
+}
+
+static Value read_value(const char *&data)
+{
+	switch (*data++)
+	{
+	case 't':
+		return true;
+	case 'f':
+		return false;
+	case 'i':
+	{
+		const size_t number = read_size(data);
+		return (number & 1) ? -static_cast<double>(number >> 1) - 1 : static_cast<double>(number >> 1);
+	}
+	case 'd':
+		return std::strtod(read_text(data).c_str(), nullptr);
+	case 's':
+		return intern(read_text(data));
+	case 'a':
+	{
+		std::vector<Value> array(read_size(data));
+		for (auto &element : array)
+		{
+			element = read_value(data);
+		}
+		return array;
+	}
+	case 'o':
+	{
+		ObjectData object;
+		for (size_t count = read_size(data); count > 0; --count)
+		{
+			const auto key = read_text(data);
+			object.insert_or_assign(key, read_value(data));
+		}
+		return object;
+	}
+	}
+
+	return Null();
+}
+
+ConstantPool::ConstantPool(const char *data, const uint32_t *offsets, size_t count)
+	: data(data), offsets(offsets), values(count), decoded(count, false)
+{
+}
+
+void ConstantPool::decode(size_t id) noexcept
+{
+	const char *position = data + offsets[id];
+	values[id] = read_value(position);
+	decoded[id] = true;
+}
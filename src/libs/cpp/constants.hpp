@@ -0,0 +1,33 @@
+#pragma once
+
+#include "value.hpp"
+#include <cstdint>
+
+// The program's constants.
+// The compiler stores them as a single binary blob (see STANDALONE.cpp.generate in cpp.lua), which is read
+// where it is, in the program's read-only data. Each constant is only decoded (and its strings interned)
+// the first time it's used, so large data tables cost nothing at startup, and nothing at all if they're never used.
+class ConstantPool
+{
+public:
+	ConstantPool(const char *data, const uint32_t *offsets, size_t count);
+
+	size_t size() const noexcept { return values.size(); }
+
+	Value &operator[](size_t id) noexcept
+	{
+		if (!decoded[id])
+		{
+			decode(id);
+		}
+		return values[id];
+	}
+
+private:
+	void decode(size_t id) noexcept;
+
+	const char *data;
+	const uint32_t *offsets;
+	std::vector<Value> values;
+	std::vector<char> decoded;
+};
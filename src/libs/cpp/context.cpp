@@ -1,7 +1,22 @@
 #include "context.hpp"
 #include <iostream>
 
+int Context::line_number() const noexcept
+{
+	return (instruction_index < line_numbers.size()) ? line_numbers[instruction_index] : 0;
+}
+
 void Context::warn(const std::string &message) const noexcept
 {
-	std::cerr << line_number << ": WARNING: " << message << std::endl;
+	std::cerr << line_number() << ": WARNING: " << message << std::endl;
+}
+
+Args Context::args() noexcept
+{
+	if (argc < 0)
+	{
+		return std::get<Array>(stack.pop());
+	}
+
+	return Args(stack.data() + stack.size() - argc, argc);
 }
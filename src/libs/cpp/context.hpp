@@ -5,6 +5,30 @@
 #include "stack.hpp"
 #include "variables.hpp"
 
+// Read-only view of the params passed to a builtin function.
+// This either wraps an imploded params array, or points directly at the stack slots holding the params.
+class Args
+{
+public:
+	Args(Array array) noexcept : array(std::move(array)), data(this->array->data()), count(this->array.size()) {}
+	Args(const Value *data, size_t count) noexcept : data(data), count(count) {}
+
+	size_t size() const noexcept { return count; }
+	bool empty() const noexcept { return count == 0; }
+
+	const Value &operator[](size_t index) const noexcept { return data[index]; }
+	const Value &front() const noexcept { return data[0]; }
+	const Value &back() const noexcept { return data[count - 1]; }
+
+	const Value *begin() const noexcept { return data; }
+	const Value *end() const noexcept { return data + count; }
+
+private:
+	Array array;
+	const Value *data;
+	size_t count;
+};
+
 struct Context
 {
 	Stack &stack;
@@ -17,7 +41,17 @@ struct Context
 
 	int arg;
 
-	int line_number;
+	// Source line of each instruction. Only looked up when reporting a warning or error.
+	const std::vector<int> &line_numbers;
+
+	// Number of params left on the stack for the function, or -1 if they were imploded into an array.
+	int argc;
+
+	// Get the params passed to the function.
+	// This must only be called once, since it pops the params array if there is one.
+	Args args() noexcept;
+
+	int line_number() const noexcept;
 
 	void warn(const std::string &message) const noexcept;
 };
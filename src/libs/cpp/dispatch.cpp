@@ -0,0 +1,368 @@
+#include "dispatch.hpp"
+#include "actions.hpp"
+#include "verifier.hpp"
+#include "profile.hpp"
+
+#include "actions/call.hpp"
+#include "actions/call_args.hpp"
+#include "actions/copy.hpp"
+#include "actions/delete_cache.hpp"
+#include "actions/delete_var.hpp"
+#include "actions/destructure.hpp"
+#include "actions/get_cache_else_jump.hpp"
+#include "actions/get_exception_type.hpp"
+#include "actions/get.hpp"
+#include "actions/jump_if_false.hpp"
+#include "actions/jump_if_nil.hpp"
+#include "actions/jump.hpp"
+#include "actions/pop_goto_index.hpp"
+#include "actions/pop_until_null.hpp"
+#include "actions/pop.hpp"
+#include "actions/push_catch_loc.hpp"
+#include "actions/push_cmd_result.hpp"
+#include "actions/push_exception.hpp"
+#include "actions/push_index.hpp"
+#include "actions/push.hpp"
+#include "actions/run_command.hpp"
+#include "actions/set_cache.hpp"
+#include "actions/set.hpp"
+#include "actions/swap.hpp"
+#include "actions/throw_exception.hpp"
+#include "actions/variable_insert.hpp"
+#include "actions/get_get.hpp"
+#include "actions/get_push.hpp"
+#include "actions/push_get.hpp"
+#include "actions/push_push.hpp"
+#include "actions/set_get.hpp"
+#include "actions/call_set.hpp"
+#include "actions/pop_jump_if_false.hpp"
+#include "actions/jump_if_nil_set.hpp"
+#include "actions/iter_begin.hpp"
+#include "actions/iter_next.hpp"
+#include "actions/iter_next_set.hpp"
+#include "actions/slice.hpp"
+
+// GCC and Clang support taking the address of a label, which lets us pre-decode
+// the program into a table of handler addresses (direct threading).
+// Every other compiler gets a plain switch over the opcode, as do profiling builds,
+// so that there's a single place to count every instruction.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(PAISLEY_PROFILE)
+#define THREADED_DISPATCH 1
+#else
+#define THREADED_DISPATCH 0
+#endif
+
+#if THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+#define TARGET(op) op:
+
+// Actions that never touch the instruction index can always move to the next slot:
+// the threaded table has a trailing `halt` entry, so this can't run off the end.
+#define DISPATCH() goto *threaded[++vm.instruction_index]
+
+// Actions that may jump have to be bounds-checked before dispatching,
+// unless the verifier has already proven that every jump target is in range.
+#define DISPATCH_JUMP()                               \
+	if constexpr (checked)                            \
+	{                                                 \
+		if (vm.instruction_index + 1 >= count)        \
+		{                                             \
+			return;                                   \
+		}                                             \
+	}                                                 \
+	DISPATCH()
+#else
+#define TARGET(op) case op:
+#define DISPATCH()              \
+	++vm.instruction_index;     \
+	continue
+#define DISPATCH_JUMP() DISPATCH()
+#endif
+
+// The interpreter loop. With `checked` off, per-instruction checks that the verifier
+// has already done for the whole program are compiled out.
+template <bool checked>
+static void execute(VirtualMachine &vm) noexcept
+{
+	const size_t count = vm.instructions.size();
+
+	if (vm.instruction_index >= count)
+	{
+		return;
+	}
+
+#if THREADED_DISPATCH
+	// Handler addresses, indexed by opcode - 1 (same order as OPERATIONS[]).
+	static const void *const handlers[] = {
+		&&OP_CALL,
+		&&OP_SET,
+		&&OP_GET,
+		&&OP_PUSH,
+		&&OP_POP,
+		&&OP_RUN_COMMAND,
+		&&OP_PUSH_CMD_RESULT,
+		&&OP_PUSH_INDEX,
+		&&OP_POP_GOTO_INDEX,
+		&&OP_COPY,
+		&&OP_DELETE_VAR,
+		&&OP_SWAP,
+		&&OP_POP_UNTIL_NULL,
+		&&OP_GET_CACHE_ELSE_JUMP,
+		&&OP_SET_CACHE,
+		&&OP_DELETE_CACHE,
+		&&OP_PUSH_CATCH_LOC,
+		&&OP_VARIABLE_INSERT,
+		&&OP_DESTRUCTURE,
+		&&OP_GET_EXCEPTION_TYPE,
+		&&OP_PUSH_EXCEPTION,
+		&&OP_THROW_EXCEPTION,
+		&&OP_JUMP,
+		&&OP_JUMP_IF_FALSE,
+		&&OP_JUMP_IF_NIL,
+		&&OP_CALL_ARGS,
+		&&OP_GET_GET,
+		&&OP_GET_PUSH,
+		&&OP_PUSH_GET,
+		&&OP_PUSH_PUSH,
+		&&OP_SET_GET,
+		&&OP_CALL_SET,
+		&&OP_POP_JUMP_IF_FALSE,
+		&&OP_JUMP_IF_NIL_SET,
+		&&OP_ITER_BEGIN,
+		&&OP_ITER_NEXT,
+		&&OP_ITER_NEXT_SET,
+		&&OP_SLICE,
+	};
+	static_assert(sizeof(handlers) / sizeof(handlers[0]) == OP_SLICE, "Handler table is out of sync with the opcode list");
+
+	// Translate the bytecode into handler addresses once, up front.
+	// Invalid opcodes are only reported if execution actually reaches them.
+	std::vector<const void *> threaded(count + 1, &&halt);
+	for (size_t i = 0; i < count; i++)
+	{
+		const size_t opcode = vm.instructions[i].opcode - 1;
+		threaded[i] = (opcode < OPERATION_COUNT) ? handlers[opcode] : &&invalid;
+	}
+
+	goto *threaded[vm.instruction_index];
+#else
+	for (;;)
+	{
+		if (vm.instruction_index >= count)
+		{
+			return;
+		}
+
+#ifdef PAISLEY_PROFILE
+		profile(vm);
+#endif
+
+		switch (vm.instructions[vm.instruction_index].opcode)
+		{
+#endif
+
+	TARGET(OP_CALL)
+	call(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_SET)
+	set(vm);
+	DISPATCH();
+
+	TARGET(OP_GET)
+	get(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH)
+	if constexpr (checked)
+	{
+		push(vm);
+	}
+	else
+	{
+		push_unchecked(vm);
+	}
+	DISPATCH();
+
+	TARGET(OP_POP)
+	pop(vm);
+	DISPATCH();
+
+	TARGET(OP_RUN_COMMAND)
+	run_command(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_PUSH_CMD_RESULT)
+	push_cmd_result(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH_INDEX)
+	push_index(vm);
+	DISPATCH();
+
+	TARGET(OP_POP_GOTO_INDEX)
+	pop_goto_index(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_COPY)
+	if constexpr (checked)
+	{
+		copy(vm);
+	}
+	else
+	{
+		copy_unchecked(vm);
+	}
+	DISPATCH();
+
+	TARGET(OP_DELETE_VAR)
+	delete_var(vm);
+	DISPATCH();
+
+	TARGET(OP_SWAP)
+	if constexpr (checked)
+	{
+		swap(vm);
+	}
+	else
+	{
+		swap_unchecked(vm);
+	}
+	DISPATCH();
+
+	TARGET(OP_POP_UNTIL_NULL)
+	pop_until_null(vm);
+	DISPATCH();
+
+	TARGET(OP_GET_CACHE_ELSE_JUMP)
+	get_cache_else_jump(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_SET_CACHE)
+	set_cache(vm);
+	DISPATCH();
+
+	TARGET(OP_DELETE_CACHE)
+	delete_cache(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH_CATCH_LOC)
+	push_catch_loc(vm);
+	DISPATCH();
+
+	TARGET(OP_VARIABLE_INSERT)
+	variable_insert(vm);
+	DISPATCH();
+
+	TARGET(OP_DESTRUCTURE)
+	destructure(vm);
+	DISPATCH();
+
+	TARGET(OP_GET_EXCEPTION_TYPE)
+	get_exception_type(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH_EXCEPTION)
+	push_exception(vm);
+	DISPATCH();
+
+	TARGET(OP_THROW_EXCEPTION)
+	throw_exception(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_JUMP)
+	jump(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_JUMP_IF_FALSE)
+	jump_if_false(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_JUMP_IF_NIL)
+	jump_if_nil(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_CALL_ARGS)
+	call_args(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_GET_GET)
+	get_get(vm);
+	DISPATCH();
+
+	TARGET(OP_GET_PUSH)
+	get_push(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH_GET)
+	push_get(vm);
+	DISPATCH();
+
+	TARGET(OP_PUSH_PUSH)
+	push_push(vm);
+	DISPATCH();
+
+	TARGET(OP_SET_GET)
+	set_get(vm);
+	DISPATCH();
+
+	TARGET(OP_CALL_SET)
+	call_set(vm);
+	DISPATCH();
+
+	TARGET(OP_POP_JUMP_IF_FALSE)
+	pop_jump_if_false(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_JUMP_IF_NIL_SET)
+	jump_if_nil_set(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_ITER_BEGIN)
+	iter_begin(vm);
+	DISPATCH();
+
+	TARGET(OP_ITER_NEXT)
+	iter_next(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_ITER_NEXT_SET)
+	iter_next_set(vm);
+	DISPATCH_JUMP();
+
+	TARGET(OP_SLICE)
+	slice(vm);
+	DISPATCH();
+
+#if THREADED_DISPATCH
+invalid:
+	vm.error("Invalid opcode: " + std::to_string(vm.instructions[vm.instruction_index].opcode));
+
+halt:
+	return;
+#else
+		default:
+			vm.error("Invalid opcode: " + std::to_string(vm.instructions[vm.instruction_index].opcode));
+			return;
+		}
+	}
+#endif
+}
+
+void run(VirtualMachine &vm) noexcept
+{
+	if (verify(vm))
+	{
+		execute<false>(vm);
+	}
+	else
+	{
+		execute<true>(vm);
+	}
+}
+
+#if THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "virtual_machine.hpp"
+
+// Run the loaded program from the current instruction index until it falls off the end.
+void run(VirtualMachine &vm) noexcept;
@@ -52,6 +52,12 @@
 #include "functions/file_exists.hpp"
 #include "functions/file_glob.hpp"
 #include "functions/file_move.hpp"
+#include "functions/cmd_spawn.hpp"
+#include "functions/cmd_await.hpp"
+#include "functions/cmd_await_any.hpp"
+#include "functions/cmd_await_all.hpp"
+#include "functions/cmd_lines.hpp"
+#include "functions/cmd_pipe.hpp"
 #include "functions/file_read.hpp"
 #include "functions/file_size.hpp"
 #include "functions/file_stat.hpp"
@@ -303,5 +309,11 @@ const Function FUNCTIONS[] = {
 	file_stat,
 	file_copy,
 	file_move,
+	cmd_spawn,
+	cmd_await,
+	cmd_await_any,
+	cmd_await_all,
+	cmd_lines,
+	cmd_pipe,
 };
 const int FUNCTION_COUNT = sizeof(FUNCTIONS) / sizeof(FUNCTIONS[0]);
@@ -2,7 +2,7 @@
 
 void append(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto lhs = params[0].to_array();
 	lhs.push_back(params[1]);
 	context.stack.push(lhs);
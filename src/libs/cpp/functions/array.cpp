@@ -3,16 +3,16 @@
 void array(Context &context) noexcept
 {
 	// Unfold an object into an array.
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 
-	if (!std::holds_alternative<std::map<std::string, Value>>(value))
+	if (!std::holds_alternative<Object>(value))
 	{
 		// If the value is not an object, return an empty array.
 		context.stack.push(std::vector<Value>());
 		return;
 	}
 
-	auto object = std::get<std::map<std::string, Value>>(value);
+	auto object = std::get<Object>(value);
 	std::vector<Value> array;
 
 	for (const auto &pair : object)
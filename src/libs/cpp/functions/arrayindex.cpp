@@ -1,4 +1,5 @@
 #include "arrayindex.hpp"
+#include "arrayslice.hpp"
 
 int get_index(const Context &context, const Value &index, int max, bool warn_if_out_of_bounds) noexcept
 {
@@ -9,7 +10,7 @@ int get_index(const Context &context, const Value &index, int max, bool warn_if_
 		// Negative indices count from the end of the array
 		if (i < 0)
 		{
-			i += context.stack.size();
+			i += max + 1;
 		}
 
 		if (i > 0 && i <= max)
@@ -36,18 +37,18 @@ int get_index(const Context &context, const Value &index, int max, bool warn_if_
 
 Value get_at_index(const Context &context, const Value &data, const Value &index) noexcept
 {
-	if (std::holds_alternative<std::vector<Value>>(data))
+	if (std::holds_alternative<Array>(data))
 	{
-		const auto &array = std::get<std::vector<Value>>(data);
+		const auto &array = std::get<Array>(data);
 		const int i = get_index(context, index, array.size(), true);
 		if (i >= 0)
 		{
-			return array[i];
+			return array.raw().element(i);
 		}
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(data))
+	else if (std::holds_alternative<Object>(data))
 	{
-		const auto &object = std::get<std::map<std::string, Value>>(data);
+		const auto &object = std::get<Object>(data);
 		const auto key = index.to_string();
 		const auto it = object.find(key);
 		if (it != object.end())
@@ -55,9 +56,9 @@ Value get_at_index(const Context &context, const Value &data, const Value &index
 			return it->second;
 		}
 	}
-	else if (std::holds_alternative<std::string>(data))
+	else if (std::holds_alternative<String>(data))
 	{
-		const std::string &string = std::get<std::string>(data);
+		const std::string &string = std::get<String>(data);
 		const int i = get_index(context, index, string.size(), false);
 		if (i >= 0)
 		{
@@ -77,26 +78,29 @@ void arrayindex(Context &context) noexcept
 	auto data = context.stack.pop();
 
 	// If index is an array, return an array of the elements at the indices in index.
-	if (std::holds_alternative<std::vector<Value>>(index))
+	if (std::holds_alternative<Array>(index))
 	{
-		const auto &indices = std::get<std::vector<Value>>(index);
+		// Indices are often a range (e.g. `a[2:5]`), so read them without filling it in.
+		const auto &indices = std::get<Array>(index).raw();
+		const size_t count = indices.length();
 
 		// If we're indexing a string, then return a string, not an array.
-		if (std::holds_alternative<std::string>(data))
+		if (std::holds_alternative<String>(data))
 		{
 			std::string result;
-			for (const Value &i : indices)
+			for (size_t i = 0; i < count; i++)
 			{
-				result += std::get<std::string>(get_at_index(context, data, i));
+				result += std::get<String>(get_at_index(context, data, indices.element(i)));
 			}
 			context.stack.push(result);
 		}
 		else
 		{
 			std::vector<Value> result;
-			for (const Value &i : indices)
+			result.reserve(count);
+			for (size_t i = 0; i < count; i++)
 			{
-				result.push_back(get_at_index(context, data, i));
+				result.push_back(get_at_index(context, data, indices.element(i)));
 			}
 			context.stack.push(result);
 		}
@@ -106,3 +110,62 @@ void arrayindex(Context &context) noexcept
 		context.stack.push(get_at_index(context, data, index));
 	}
 }
+
+// Map a 1-based slice bound to a 0-based offset, with negative bounds counting from the end.
+static long long slice_offset(int bound, size_t length) noexcept
+{
+	return (bound < 0) ? static_cast<long long>(length) + bound : bound - 1;
+}
+
+void arrayindex_slice(Context &context) noexcept
+{
+	const int end = context.stack.pop().to_number();
+	const int start = context.stack.pop().to_number();
+	auto data = context.stack.pop();
+
+	// If both bounds are on the same side of zero, the slice is one contiguous run,
+	// and if it's in bounds it can be copied in one go.
+	if ((start > 0 && end > 0) || (start < 0 && end < 0))
+	{
+		if (std::holds_alternative<String>(data))
+		{
+			const std::string &string = std::get<String>(data);
+			const long long first = slice_offset(start, string.size());
+			const long long last = slice_offset(end, string.size());
+
+			if (first >= 0 && first <= last && last < static_cast<long long>(string.size()))
+			{
+				context.stack.push(string.substr(first, last - first + 1));
+				return;
+			}
+		}
+		else if (std::holds_alternative<Array>(data))
+		{
+			const auto &array = std::get<Array>(data);
+			const long long first = slice_offset(start, array.size());
+			const long long last = slice_offset(end, array.size());
+
+			if (first >= 0 && first <= last && last < static_cast<long long>(array.size()))
+			{
+				// A slice of a range is another range.
+				const auto &raw = array.raw();
+				if (raw.is_range())
+				{
+					context.stack.push(Array(ArrayData::range(raw.range_first() + first, last - first + 1)));
+				}
+				else
+				{
+					context.stack.push(std::vector<Value>(raw.begin() + first, raw.begin() + last + 1));
+				}
+				return;
+			}
+		}
+	}
+
+	// Anything else (empty or out of bounds slices, objects, ...) gets the general treatment.
+	context.stack.push(std::move(data));
+	context.stack.push(start);
+	context.stack.push(end);
+	arrayslice(context);
+	arrayindex(context);
+}
@@ -3,3 +3,7 @@
 #include "../context.hpp"
 
 void arrayindex(Context &) noexcept;
+
+// Same as arrayslice followed by arrayindex, but copies string and array slices directly,
+// instead of looking up each index one at a time.
+void arrayindex_slice(Context &) noexcept;
@@ -2,30 +2,17 @@
 
 void arrayslice(Context &context) noexcept
 {
-	int end = context.stack.pop().to_number();
-	int start = context.stack.pop().to_number();
+	const int end = context.stack.pop().to_number();
+	const int start = context.stack.pop().to_number();
 
-	int length = end - start + 1;
-	if (length > 32768)
+	// The range is only stored as its bounds, so it can be any size.
+	// Its elements are filled in if something other than a loop, sum, length, index or `in` needs them.
+	const long long length = static_cast<long long>(end) - start + 1;
+	if (length <= 0)
 	{
-		context.warn("Attempted to create an array with " + std::to_string(length) + " elements (max is 32768). Array truncated.");
-		end = start + 32767;
-		length = 32768;
+		context.stack.push(std::vector<Value>());
+		return;
 	}
 
-	if (length < 0)
-	{
-		length = 0;
-	}
-
-	std::vector<Value> result;
-	result.reserve(length);
-
-	for (int i = start; i <= end; i++)
-	{
-		const Value value(i);
-		result.push_back(value);
-	}
-
-	context.stack.push(result);
+	context.stack.push(Array(ArrayData::range(start, length)));
 }
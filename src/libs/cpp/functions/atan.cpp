@@ -2,7 +2,7 @@
 
 void atan(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto value = params[0].to_number();
 
 	context.stack.push(std::atan(value));
@@ -2,7 +2,7 @@
 
 void atan2(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto x = params[0].to_number();
 	auto y = params[1].to_number();
 
@@ -4,7 +4,7 @@
 void b64_decode(Context &context) noexcept
 {
 	// Decode a base64 string
-	auto str = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto str = context.args()[0].to_string();
 
 	static const char *base64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
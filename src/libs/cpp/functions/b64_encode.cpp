@@ -3,7 +3,7 @@
 void b64_encode(Context &context) noexcept
 {
 	// Encode a string to base64
-	auto str = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto str = context.args()[0].to_string();
 
 	std::string encoded;
 	encoded.reserve(((str.size() + 2) / 3) * 4);
@@ -3,7 +3,7 @@
 void bytes(Context &context) noexcept
 {
 	// Split a number into a list of bytes
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	long value = params[0].to_number();
 	const int num_bytes = params[1].to_number();
 
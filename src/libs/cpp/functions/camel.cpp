@@ -3,7 +3,7 @@
 
 void camel(Context &context) noexcept
 {
-	auto str = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto str = context.args()[0].to_string();
 
 	// Capitalize first letter
 	str[0] = std::toupper(str[0]);
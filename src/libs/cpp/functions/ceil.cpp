@@ -3,6 +3,6 @@
 
 void ceil(Context &context) noexcept
 {
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0].to_number();
+	auto value = context.args()[0].to_number();
 	context.stack.push(std::ceil(value));
 }
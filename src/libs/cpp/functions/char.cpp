@@ -3,6 +3,6 @@
 void _char(Context &context) noexcept
 {
 	// Convert a number to a character.
-	auto param = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto param = context.args()[0];
 	context.stack.push(std::string(1, static_cast<char>(param.to_number())));
 }
@@ -4,16 +4,16 @@
 // If the array can't be split evenly, the final chunk will be smaller than the specified size.
 void chunk(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (!std::holds_alternative<std::vector<Value>>(params[0]))
+	if (!std::holds_alternative<Array>(params[0]))
 	{
 		context.warn("WARNING: chunk() first argument is not an array! Coercing to an empty array.");
 		context.stack.push(std::vector<Value>{});
 		return;
 	}
 
-	const auto array = std::get<std::vector<Value>>(params[0]);
+	const auto array = std::get<Array>(params[0]);
 	const long size = params[1].to_number();
 
 	if (size < 1)
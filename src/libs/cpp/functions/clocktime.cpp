@@ -3,7 +3,7 @@
 void clocktime(Context &context) noexcept
 {
 	// Convert a "seconds since midnight" timestamp into (hour, min, sec, milli)
-	const auto timestamp = std::get<std::vector<Value>>(context.stack.pop())[0].to_number();
+	const auto timestamp = context.args()[0].to_number();
 	const int seconds = timestamp;
 
 	context.stack.push({
@@ -0,0 +1,17 @@
+#include "cmd_await.hpp"
+#include "../process.hpp"
+
+void cmd_await(Context &context) noexcept
+{
+	const auto handle = context.args()[0].to_number();
+
+	ProcessResult result;
+	if (handle >= 1 && process_pool().await(static_cast<size_t>(handle), result))
+	{
+		context.stack.push(result.to_value());
+	}
+	else
+	{
+		context.stack.push(Value());
+	}
+}
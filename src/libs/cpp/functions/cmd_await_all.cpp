@@ -0,0 +1,25 @@
+#include "cmd_await_all.hpp"
+#include "../process.hpp"
+
+void cmd_await_all(Context &context) noexcept
+{
+	// The commands are all read from at the same time while waiting,
+	// so the order they're collected in doesn't hold any of them up.
+	std::vector<Value> results;
+	for (const auto &value : context.args()[0].to_array())
+	{
+		const auto handle = value.to_number();
+
+		ProcessResult result;
+		if (handle >= 1 && process_pool().await(static_cast<size_t>(handle), result))
+		{
+			results.push_back(result.to_value());
+		}
+		else
+		{
+			results.push_back(Value());
+		}
+	}
+
+	context.stack.push(results);
+}
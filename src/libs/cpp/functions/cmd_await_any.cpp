@@ -0,0 +1,25 @@
+#include "cmd_await_any.hpp"
+#include "../process.hpp"
+
+void cmd_await_any(Context &context) noexcept
+{
+	std::vector<size_t> handles;
+	for (const auto &value : context.args()[0].to_array())
+	{
+		const auto handle = value.to_number();
+		if (handle >= 1)
+		{
+			handles.push_back(static_cast<size_t>(handle));
+		}
+	}
+
+	const auto handle = process_pool().await_any(handles);
+	if (handle)
+	{
+		context.stack.push(static_cast<double>(handle));
+	}
+	else
+	{
+		context.stack.push(Value());
+	}
+}
@@ -0,0 +1,16 @@
+#include "cmd_lines.hpp"
+#include "../process.hpp"
+
+void cmd_lines(Context &context) noexcept
+{
+	const auto argv = command_argv(context.args()[0]);
+	if (argv.empty())
+	{
+		context.warn("cmd_lines() was given an empty command.");
+		context.stack.push(Array());
+		return;
+	}
+
+	// The command starts now, but its output is only read as the lines are used.
+	context.stack.push(Array(ArrayData::stream(std::make_shared<LineStream>(argv))));
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "../context.hpp"
+
+void cmd_lines(Context &) noexcept;
@@ -0,0 +1,62 @@
+#include "cmd_pipe.hpp"
+#include "../process.hpp"
+#include "../shell_utils.hpp"
+
+void cmd_pipe(Context &context) noexcept
+{
+	auto params = context.args();
+
+	if (!std::holds_alternative<Array>(params[0]))
+	{
+		context.warn("cmd_pipe() first argument is not an array of commands!");
+		context.stack.push(Value());
+		return;
+	}
+
+	const auto commands = std::get<Array>(params[0]);
+	std::vector<PipelineStage> stages(commands.size());
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		stages[i].argv = command_argv(commands[i]);
+		if (stages[i].argv.empty())
+		{
+			context.warn("cmd_pipe() was given an empty command.");
+			context.stack.push(Value());
+			return;
+		}
+	}
+
+	if (stages.empty())
+	{
+		context.warn("cmd_pipe() was given no commands.");
+		context.stack.push(Value());
+		return;
+	}
+
+	// An array of lines is written with a line break after each one.
+	if (params.size() > 1 && !params[1].is_null())
+	{
+		auto &first = stages[0];
+		first.has_input = true;
+		if (std::holds_alternative<Array>(params[1]))
+		{
+			const auto lines = std::get<Array>(params[1]);
+			for (size_t i = 0; i < lines.size(); ++i)
+			{
+				first.input += lines[i].to_string();
+				first.input += '\n';
+			}
+		}
+		else
+		{
+			first.input = params[1].to_string();
+		}
+	}
+
+	ProcessResult result;
+	if (!run_shell_utils(stages, result))
+	{
+		result = run_pipeline(stages, false, false);
+	}
+	context.stack.push(result.to_value());
+}
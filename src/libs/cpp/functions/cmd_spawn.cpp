@@ -0,0 +1,28 @@
+#include "cmd_spawn.hpp"
+#include "../process.hpp"
+
+#include <algorithm>
+#include <unistd.h>
+
+void cmd_spawn(Context &context) noexcept
+{
+	auto params = context.args();
+	const auto argv = command_argv(params[0]);
+
+	if (argv.empty())
+	{
+		context.warn("cmd_spawn() was given an empty command.");
+		context.stack.push(Value());
+		return;
+	}
+
+	// By default, run as many commands at once as there are CPU cores.
+	double max_running = static_cast<double>(sysconf(_SC_NPROCESSORS_ONLN));
+	if (params.size() > 1 && !params[1].is_null())
+	{
+		max_running = params[1].to_number();
+	}
+
+	const auto handle = process_pool().spawn(argv, static_cast<size_t>(std::max(max_running, 1.0)));
+	context.stack.push(static_cast<double>(handle));
+}
@@ -3,6 +3,6 @@
 void cosh(Context &context) noexcept
 {
 	// Hyperbolic cosine of a number.
-	auto param = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto param = context.args()[0];
 	context.stack.push(std::cosh(param.to_number()));
 }
@@ -3,12 +3,12 @@
 void count(Context &context) noexcept
 {
 	// Count the number of occurrences of a value in an array or string.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	int count = 0;
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]))
+	if (std::holds_alternative<Array>(params[0]))
 	{
-		auto array = std::get<std::vector<Value>>(params[0]);
+		auto array = std::get<Array>(params[0]);
 		Value value = params[1];
 
 		for (const Value &element : array)
@@ -19,10 +19,10 @@ void count(Context &context) noexcept
 			}
 		}
 	}
-	else if (std::holds_alternative<std::string>(params[0]))
+	else if (std::holds_alternative<String>(params[0]))
 	{
-		std::string str = std::get<std::string>(params[0]);
-		std::string substr = std::get<std::string>(params[1]);
+		std::string str = std::get<String>(params[0]);
+		std::string substr = std::get<String>(params[1]);
 
 		size_t pos = 0;
 		while ((pos = str.find(substr, pos)) != std::string::npos)
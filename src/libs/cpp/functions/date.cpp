@@ -6,12 +6,12 @@ void date(Context &context) noexcept
 {
 	// Convert an array representation of a date (day, month, year) into an ISO compliant date string.
 
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	std::string result;
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]))
+	if (std::holds_alternative<Array>(params[0]))
 	{
-		auto date = std::get<std::vector<Value>>(params[0]);
+		auto date = std::get<Array>(params[0]);
 		if (date.size() >= 3)
 		{
 			int day = date[0].to_number();
@@ -3,7 +3,7 @@
 void _delete(Context &context) noexcept
 {
 	// Remove an element from an array
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto array = params[0].to_array();
 	int index = params[1].to_number();
 
@@ -1,20 +1,22 @@
 #include "difference.hpp"
-#include <algorithm>
+#include <unordered_set>
 
 void difference(Context &context) noexcept
 {
 	// Find the difference of two arrays.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]) && std::holds_alternative<std::vector<Value>>(params[1]))
+	if (std::holds_alternative<Array>(params[0]) && std::holds_alternative<Array>(params[1]))
 	{
-		auto array1 = std::get<std::vector<Value>>(params[0]);
-		auto array2 = std::get<std::vector<Value>>(params[1]);
+		auto array1 = std::get<Array>(params[0]);
+		auto array2 = std::get<Array>(params[1]);
+
+		const std::unordered_set<Value> lookup(array2.begin(), array2.end());
 
 		std::vector<Value> result;
 		for (const Value &value : array1)
 		{
-			if (std::find(array2.begin(), array2.end(), value) == array2.end())
+			if (!lookup.count(value))
 			{
 				result.push_back(value);
 			}
@@ -26,7 +28,7 @@ void difference(Context &context) noexcept
 	{
 		context.warn("Difference requires two arrays. Result may be unexpected.");
 
-		if (std::holds_alternative<std::vector<Value>>(params[0]))
+		if (std::holds_alternative<Array>(params[0]))
 		{
 			context.stack.push(params[0]);
 		}
@@ -27,7 +27,7 @@ bool _dir_create(const std::string &path, bool recursive) noexcept
 
 void dir_create(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto path = params[0].to_string();
 	bool recursive = params.size() > 1 ? params[1].to_bool() : false;
 
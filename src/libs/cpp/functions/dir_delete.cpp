@@ -26,7 +26,7 @@ bool _dir_delete(const std::string &path, bool recursive) noexcept
 
 void dir_delete(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto path = params[0].to_string();
 	bool recursive = params.size() > 1 ? params[1].to_bool() : false;
 	context.stack.push(_dir_delete(path, recursive));
@@ -4,7 +4,7 @@
 
 void dir_list(Context &context) noexcept
 {
-	auto path = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto path = context.args()[0].to_string();
 
 	std::vector<Value> files;
 	for (const auto &entry : std::filesystem::directory_iterator(path))
@@ -2,7 +2,7 @@
 
 void dist(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto point1 = params[0].to_array();
 	auto point2 = params[1].to_array();
 
@@ -3,7 +3,7 @@
 void endswith(Context &context) noexcept
 {
 	// Check if a string ends with another string.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	const auto &str = params[0].to_string();
 	const auto &substr = params[1].to_string();
 
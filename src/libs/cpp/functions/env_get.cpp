@@ -3,7 +3,7 @@
 void env_get(Context &context) noexcept
 {
 	// Get an environment variable.
-	auto name = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto name = context.args()[0].to_string();
 
 	const char *value = std::getenv(name.c_str());
 	if (value)
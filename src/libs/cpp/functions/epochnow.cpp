@@ -3,6 +3,6 @@
 
 void epochnow(Context &context) noexcept
 {
-	context.stack.pop();
+	context.args();
 	context.stack.push(time(nullptr));
 }
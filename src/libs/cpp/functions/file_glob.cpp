@@ -6,7 +6,7 @@
 
 void file_glob(Context &context) noexcept
 {
-	auto pattern = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto pattern = context.args()[0].to_string();
 
 	glob_t glob_result;
 	glob(pattern.c_str(), GLOB_TILDE, nullptr, &glob_result);
@@ -4,7 +4,7 @@
 
 void file_move(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto source = params[0].to_string();
 	auto destination = params[1].to_string();
 	bool overwrite = params.size() > 2 ? params[2].to_bool() : false;
@@ -4,7 +4,7 @@
 
 void file_read(Context &context) noexcept
 {
-	auto path = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto path = context.args()[0].to_string();
 
 	std::ifstream file(path);
 	if (!file)
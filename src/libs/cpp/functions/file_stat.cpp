@@ -4,7 +4,7 @@
 
 void file_stat(Context &context) noexcept
 {
-	auto path = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto path = context.args()[0].to_string();
 
 	struct stat info;
 	if (stat(path.c_str(), &info) != 0)
@@ -25,7 +25,7 @@ void file_stat(Context &context) noexcept
 		permissions += (info.st_mode & S_IWOTH ? "w" : "-");
 		permissions += (info.st_mode & S_IXOTH ? "x" : "-");
 
-		auto object = std::map<std::string, Value>{
+		auto object = ObjectData{
 			{"gid", static_cast<double>(info.st_gid)},
 			{"size", static_cast<double>(info.st_size)},
 			{"uid", static_cast<double>(info.st_uid)},
@@ -4,7 +4,7 @@
 
 void file_type(Context &context) noexcept
 {
-	auto path = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto path = context.args()[0].to_string();
 
 	struct stat info;
 	if (stat(path.c_str(), &info) != 0)
@@ -4,7 +4,7 @@
 
 void file_write(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto path = params[0].to_string();
 	auto content = params[1].to_string();
 
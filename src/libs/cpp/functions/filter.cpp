@@ -3,21 +3,43 @@
 
 void filter(Context &context) noexcept
 {
-	// Remove all characters from a string that do not match the given pattern
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
-	const auto &str = params[0].to_string();
-	const auto &pattern = params[1].to_string();
+	// Keep only the parts of a string that match the given pattern.
+	// Like the Lua runtime, the pattern is matched at the start of what's left of the string:
+	// a match is kept and skipped over, otherwise a single character is dropped.
+	auto params = context.args();
+	const auto str = params[0].to_string();
+	const auto pattern = params[1].to_string();
 
 	std::string result;
 	result.reserve(str.size());
 
-	for (const char &c : str)
+	try
 	{
-		if (lua_match(std::string(1, c), '^' + pattern).size())
+		const auto anchored = lua_pattern('^' + pattern);
+		const std::string_view text(str);
+		LuaMatch match;
+
+		size_t i = 0;
+		while (i < str.size())
 		{
-			result.push_back(c);
+			// Matching against the rest of the string means that `%f` and `$` see the same thing they would in Lua.
+			if (anchored->find(text.substr(i), 0, match))
+			{
+				const auto kept = match.captures[0].to_string();
+				if (!kept.empty())
+				{
+					result += kept;
+					i += kept.size();
+					continue;
+				}
+			}
+			i++;
 		}
 	}
+	catch (const std::runtime_error &e)
+	{
+		context.warn(e.what());
+	}
 
 	context.stack.push(result);
 }
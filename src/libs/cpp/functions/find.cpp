@@ -3,14 +3,14 @@
 void find(Context &context) noexcept
 {
 	// Find the index of the nth occurrence of a value in an array or string.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	int nth_occurrence = params[3].to_number();
 	int index = -1;
 	int occurrence = 0;
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]))
+	if (std::holds_alternative<Array>(params[0]))
 	{
-		auto array = std::get<std::vector<Value>>(params[0]);
+		auto array = std::get<Array>(params[0]);
 		Value value = params[1];
 
 		for (size_t i = 0; i < array.size(); i++)
@@ -29,7 +29,7 @@ void find(Context &context) noexcept
 	else
 	{
 		std::string str = params[0].to_string();
-		std::string substr = std::get<std::string>(params[1]);
+		std::string substr = std::get<String>(params[1]);
 
 		for (int i = 0; i < nth_occurrence; i++)
 		{
@@ -6,9 +6,9 @@ std::vector<Value> flatten_recursive(const std::vector<Value> &array, int depth)
 
 	for (const Value &value : array)
 	{
-		if (depth > 0 && std::holds_alternative<std::vector<Value>>(value))
+		if (depth > 0 && std::holds_alternative<Array>(value))
 		{
-			const auto subarray = flatten_recursive(std::get<std::vector<Value>>(value), depth - 1);
+			const auto subarray = flatten_recursive(std::get<Array>(value), depth - 1);
 			result.reserve(result.size() + subarray.size());
 
 			for (const auto &element : subarray)
@@ -28,15 +28,15 @@ std::vector<Value> flatten_recursive(const std::vector<Value> &array, int depth)
 void flatten(Context &context) noexcept
 {
 	// Flatten an array of any dimension into a 1D array.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto param = params[0];
 	int depth = (params.size() > 1) ? params[1].to_number() : std::numeric_limits<int>::max();
 
-	if (!std::holds_alternative<std::vector<Value>>(param))
+	if (!std::holds_alternative<Array>(param))
 	{
 		context.stack.push(flatten_recursive(param.to_array(), depth));
 		return;
 	}
 
-	context.stack.push(flatten_recursive(std::get<std::vector<Value>>(param), depth));
+	context.stack.push(flatten_recursive(std::get<Array>(param), depth));
 }
@@ -3,7 +3,7 @@
 void fmod(Context &context) noexcept
 {
 	// Return the floating point remainder of x / y (x mod y).
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double x = params[0].to_number();
 	double y = params[1].to_number();
 
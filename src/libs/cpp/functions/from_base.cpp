@@ -14,7 +14,7 @@ int from_base(char c) noexcept
 void from_base(Context &context) noexcept
 {
 	// Convert a string representation of a number in a given base to a floating point number.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	std::string text = params[0].to_string();
 	int base = static_cast<int>(params[1].to_number());
 
@@ -3,7 +3,7 @@
 void frombytes(Context &context) noexcept
 {
 	// Convert a list of bytes into a number
-	auto bytes = std::get<std::vector<Value>>(context.stack.pop());
+	auto bytes = context.args();
 	int result = 0;
 	for (const Value &byte : bytes)
 	{
@@ -3,13 +3,13 @@
 
 void fromepoch(Context &context) noexcept
 {
-	auto timestamp = std::get<std::vector<Value>>(context.stack.pop())[0].to_number();
+	auto timestamp = context.args()[0].to_number();
 	time_t rawtime = static_cast<time_t>(timestamp);
 
 	struct tm timeinfo;
 	localtime_r(&rawtime, &timeinfo);
 
-	const auto result = std::map<std::string, Value>{
+	const auto result = ObjectData{
 		{"date",
 		 std::vector<Value>{
 			 timeinfo.tm_mday,
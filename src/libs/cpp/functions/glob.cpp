@@ -3,7 +3,7 @@
 
 void glob(Context &context) noexcept
 {
-	auto values = std::get<std::vector<Value>>(context.stack.pop());
+	auto values = context.args();
 	auto pattern = values[0].to_string();
 
 	std::vector<Value> result;
@@ -11,9 +11,9 @@ void glob(Context &context) noexcept
 	// Replace all occurences of "*" with the appropriate string.
 	for (size_t i = 1; i < values.size(); i++)
 	{
-		if (std::holds_alternative<std::vector<Value>>(values[i]))
+		if (std::holds_alternative<Array>(values[i]))
 		{
-			for (auto &value : std::get<std::vector<Value>>(values[i]))
+			for (auto &value : std::get<Array>(values[i]))
 			{
 				auto val = replace(pattern, "*", value.to_string());
 				result.push_back(val);
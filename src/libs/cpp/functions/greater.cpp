@@ -7,9 +7,9 @@ void greater(Context &context) noexcept
 
 	make_comparable(lhs, rhs);
 
-	if (std::holds_alternative<std::string>(lhs))
+	if (std::holds_alternative<String>(lhs))
 	{
-		context.stack.push(std::get<std::string>(lhs) > std::get<std::string>(rhs));
+		context.stack.push(std::get<String>(lhs) > std::get<String>(rhs));
 	}
 	else
 	{
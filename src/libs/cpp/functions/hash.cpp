@@ -6,7 +6,7 @@
 void hash(Context &context) noexcept
 {
 	// Generate a sha256 hash of a string.
-	auto str = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto str = context.args()[0].to_string();
 
 	unsigned char hash[SHA256_DIGEST_LENGTH];
 	SHA256((const unsigned char *)str.c_str(), str.size(), hash);
@@ -1,4 +1,5 @@
 #include "inarray.hpp"
+#include <cmath>
 
 void inarray(Context &context) noexcept
 {
@@ -7,9 +8,20 @@ void inarray(Context &context) noexcept
 
 	bool result = false;
 
-	if (std::holds_alternative<std::vector<Value>>(data))
+	if (std::holds_alternative<Array>(data) && std::get<Array>(data).raw().is_range())
 	{
-		const auto &values = std::get<std::vector<Value>>(data);
+		// A range holds every integer between its bounds.
+		const auto &range = std::get<Array>(data).raw();
+		if (std::holds_alternative<double>(value))
+		{
+			const double number = std::get<double>(value);
+			const double offset = number - range.range_first();
+			result = number == std::floor(number) && offset >= 0 && offset < range.length();
+		}
+	}
+	else if (std::holds_alternative<Array>(data))
+	{
+		const auto &values = std::get<Array>(data);
 		for (const auto &v : values)
 		{
 			if (v == value)
@@ -19,18 +31,18 @@ void inarray(Context &context) noexcept
 			}
 		}
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(data))
+	else if (std::holds_alternative<Object>(data))
 	{
-		const auto &object = std::get<std::map<std::string, Value>>(data);
+		const auto &object = std::get<Object>(data);
 		const auto key = value.to_string();
 		if (object.find(key) != object.end())
 		{
 			result = true;
 		}
 	}
-	else if (std::holds_alternative<std::string>(data))
+	else if (std::holds_alternative<String>(data))
 	{
-		const auto &string = std::get<std::string>(data);
+		const auto &string = std::get<String>(data);
 		const auto search = value.to_string();
 
 		if (string.find(search) != std::string::npos)
@@ -2,12 +2,12 @@
 
 void index(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
 	int index = 0;
-	if (std::holds_alternative<std::vector<Value>>(params[0]))
+	if (std::holds_alternative<Array>(params[0]))
 	{
-		auto lhs = std::get<std::vector<Value>>(params[0]);
+		auto lhs = std::get<Array>(params[0]);
 		auto rhs = params[1];
 
 		// Find the index of the rhs in the lhs
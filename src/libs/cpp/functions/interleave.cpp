@@ -3,12 +3,12 @@
 void interleave(Context &context) noexcept
 {
 	// Interleave two arrays.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]) && std::holds_alternative<std::vector<Value>>(params[1]))
+	if (std::holds_alternative<Array>(params[0]) && std::holds_alternative<Array>(params[1]))
 	{
-		auto array1 = std::get<std::vector<Value>>(params[0]);
-		auto array2 = std::get<std::vector<Value>>(params[1]);
+		auto array1 = std::get<Array>(params[0]);
+		auto array2 = std::get<Array>(params[1]);
 
 		std::vector<Value> result;
 		for (int i = 0; i < (int)array1.size() || i < (int)array2.size(); i++)
@@ -29,11 +29,11 @@ void interleave(Context &context) noexcept
 	{
 		context.warn("Interleave requires two arrays. Result may be unexpected.");
 
-		if (std::holds_alternative<std::vector<Value>>(params[0]))
+		if (std::holds_alternative<Array>(params[0]))
 		{
 			context.stack.push(params[0]);
 		}
-		else if (std::holds_alternative<std::vector<Value>>(params[1]))
+		else if (std::holds_alternative<Array>(params[1]))
 		{
 			context.stack.push(params[1]);
 		}
@@ -1,20 +1,22 @@
 #include "is_superset.hpp"
-#include <algorithm>
+#include <unordered_set>
 
 void is_superset(Context &context) noexcept
 {
 	// Check if the first array is a superset of the second array.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]) && std::holds_alternative<std::vector<Value>>(params[1]))
+	if (std::holds_alternative<Array>(params[0]) && std::holds_alternative<Array>(params[1]))
 	{
-		auto array1 = std::get<std::vector<Value>>(params[0]);
-		auto array2 = std::get<std::vector<Value>>(params[1]);
+		auto array1 = std::get<Array>(params[0]);
+		auto array2 = std::get<Array>(params[1]);
+
+		const std::unordered_set<Value> lookup(array1.begin(), array1.end());
 
 		bool result = true;
 		for (const Value &value : array2)
 		{
-			if (std::find(array1.begin(), array1.end(), value) == array1.end())
+			if (!lookup.count(value))
 			{
 				result = false;
 				break;
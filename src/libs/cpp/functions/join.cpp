@@ -2,7 +2,7 @@
 
 void join(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto values = params[0].to_array();
 	auto delimiter = params[1].to_string();
 
@@ -210,7 +210,7 @@ Value json_decode_recursive(std::string::const_iterator &it, const std::string::
 	if (*it == '{')
 	{
 		// Object
-		std::map<std::string, Value> object;
+		ObjectData object;
 		for (++it; it != end; it++)
 		{
 			if (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r')
@@ -231,7 +231,7 @@ Value json_decode_recursive(std::string::const_iterator &it, const std::string::
 			if (*it == '"')
 			{
 				auto key = json_decode_recursive(it, end, line_no);
-				if (!std::holds_alternative<std::string>(key))
+				if (!std::holds_alternative<String>(key))
 				{
 					throw JsonError("Object key is not a string", line_no);
 				}
@@ -248,7 +248,7 @@ Value json_decode_recursive(std::string::const_iterator &it, const std::string::
 
 				it++;
 				auto value = json_decode_recursive(it, end, line_no);
-				object[std::get<std::string>(key)] = value;
+				object[std::get<String>(key)] = value;
 				continue;
 			}
 
@@ -313,16 +313,16 @@ Value json_decode_recursive(std::string::const_iterator &it, const std::string::
 
 void json_decode(Context &context)
 {
-	auto json = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto json = context.args()[0];
 
-	if (!std::holds_alternative<std::string>(json))
+	if (!std::holds_alternative<String>(json))
 	{
 		throw std::runtime_error("Input to json_decode is not a string");
 	}
 
-	const std::string &json_str = std::get<std::string>(json);
+	const std::string &json_str = std::get<String>(json);
 	std::string::const_iterator it = json_str.begin();
-	auto value = json_decode_recursive(it, json_str.end(), context.line_number);
+	auto value = json_decode_recursive(it, json_str.end(), context.line_number());
 
 	context.stack.push(value);
 }
@@ -39,13 +39,13 @@ std::string json_indent(int indent) noexcept
 	return json;
 }
 
-std::string json_encode_recursive(Value &data, bool pretty = false, int indent = 0) noexcept
+std::string json_encode_recursive(const Value &data, bool pretty = false, int indent = 0) noexcept
 {
 	std::string json;
 
-	if (std::holds_alternative<std::vector<Value>>(data))
+	if (std::holds_alternative<Array>(data))
 	{
-		auto array = std::get<std::vector<Value>>(data);
+		auto array = std::get<Array>(data);
 
 		json += "[";
 
@@ -77,9 +77,9 @@ std::string json_encode_recursive(Value &data, bool pretty = false, int indent =
 		}
 		json += "]";
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(data))
+	else if (std::holds_alternative<Object>(data))
 	{
-		auto object = std::get<std::map<std::string, Value>>(data);
+		auto object = std::get<Object>(data);
 
 		json += "{";
 
@@ -120,9 +120,9 @@ std::string json_encode_recursive(Value &data, bool pretty = false, int indent =
 		}
 		json += "}";
 	}
-	else if (std::holds_alternative<std::string>(data))
+	else if (std::holds_alternative<String>(data))
 	{
-		json += "\"" + escape_string(std::get<std::string>(data)) + "\"";
+		json += "\"" + escape_string(std::get<String>(data)) + "\"";
 	}
 	else if (std::holds_alternative<double>(data))
 	{
@@ -142,7 +142,7 @@ std::string json_encode_recursive(Value &data, bool pretty = false, int indent =
 
 void json_encode(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto data = params[0];
 	auto pretty = params.size() > 1 ? params[1].to_bool() : false;
 
@@ -253,15 +253,15 @@ bool json_validate_recursive(std::string::const_iterator &it, const std::string:
 
 void json_valid(Context &context) noexcept
 {
-	auto json = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto json = context.args()[0];
 
-	if (!std::holds_alternative<std::string>(json))
+	if (!std::holds_alternative<String>(json))
 	{
 		context.stack.push(false);
 		return;
 	}
 
-	const std::string &json_str = std::get<std::string>(json);
+	const std::string &json_str = std::get<String>(json);
 	std::string::const_iterator it = json_str.begin();
 	bool valid = json_validate_recursive(it, json_str.end());
 
@@ -4,7 +4,7 @@ void jumpifnil(Context &context) noexcept
 {
 	const Value &top = context.stack.back();
 
-	if (top.is_null()) // Hack to correctly check for null variant
+	if (top.is_null())
 	{
 		context.instruction_index = context.arg;
 	}
@@ -3,22 +3,22 @@
 void keys(Context &context) noexcept
 {
 	// Get the keys of an object or array.
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 
 	std::vector<Value> keys;
 
-	if (std::holds_alternative<std::vector<Value>>(value))
+	if (std::holds_alternative<Array>(value))
 	{
-		auto array = std::get<std::vector<Value>>(value);
+		auto array = std::get<Array>(value);
 
 		for (int i = 0; i < (int)array.size(); i++)
 		{
 			keys.push_back(i + 1);
 		}
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(value))
+	else if (std::holds_alternative<Object>(value))
 	{
-		auto object = std::get<std::map<std::string, Value>>(value);
+		auto object = std::get<Object>(value);
 
 		for (const auto &pair : object)
 		{
@@ -7,13 +7,13 @@ void length(Context &context) noexcept
 	double result = 0;
 
 	// Length only makes sense for strings and arrays
-	if (std::holds_alternative<std::string>(value))
+	if (std::holds_alternative<String>(value))
 	{
-		result = static_cast<double>(std::get<std::string>(value).size());
+		result = static_cast<double>(std::get<String>(value).size());
 	}
-	else if (std::holds_alternative<std::vector<Value>>(value))
+	else if (std::holds_alternative<Array>(value))
 	{
-		result = static_cast<double>(std::get<std::vector<Value>>(value).size());
+		result = static_cast<double>(std::get<Array>(value).size());
 	}
 
 	context.stack.push(result);
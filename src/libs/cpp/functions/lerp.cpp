@@ -3,12 +3,12 @@
 void lerp(Context &context) noexcept
 {
 	// Linear interpolation between two numbers or vectors.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto ratio = params[0].to_number();
 	auto a = params[1];
 	auto b = params[2];
 
-	if (std::holds_alternative<std::vector<Value>>(a) || std::holds_alternative<std::vector<Value>>(b))
+	if (std::holds_alternative<Array>(a) || std::holds_alternative<Array>(b))
 	{
 		auto arr_a = a.to_array();
 		auto arr_b = b.to_array();
@@ -3,7 +3,7 @@
 
 void log(Context &context) noexcept
 {
-	auto values = std::get<std::vector<Value>>(context.stack.pop());
+	auto values = context.args();
 	auto number = values[0].to_number();
 	auto base = values[1];
 
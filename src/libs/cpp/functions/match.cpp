@@ -3,19 +3,25 @@
 
 void match(Context &context) noexcept
 {
-	// Check if a string matches a pattern
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	// Get the first capture of the first match of a pattern, or null if there's no match.
+	auto params = context.args();
 
 	auto str = params[0].to_string();
 	auto pattern = params[1].to_string();
 
-	auto value = lua_match(str, pattern);
-
-	if (value.empty())
+	try
+	{
+		LuaMatch result;
+		if (lua_pattern(pattern)->find(str, 0, result))
+		{
+			context.stack.push(std::move(result.captures[0]));
+			return;
+		}
+	}
+	catch (const std::runtime_error &e)
 	{
-		context.stack.push(Null());
-		return;
+		context.warn(e.what());
 	}
 
-	context.stack.push(value[0]);
+	context.stack.push(Null());
 }
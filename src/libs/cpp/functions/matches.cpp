@@ -3,22 +3,19 @@
 
 void matches(Context &context) noexcept
 {
-	// Check if a string matches a pattern
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	// Get the first capture of every match of a pattern.
+	auto params = context.args();
 
 	auto str = params[0].to_string();
 	auto pattern = params[1].to_string();
 
-	auto value = lua_match(str, pattern);
-
-	// Convert matches to an array of values
-	std::vector<Value> values;
-	values.reserve(value.size());
-
-	for (const auto &v : value)
+	try
 	{
-		values.push_back(v);
+		context.stack.push(lua_pattern(pattern)->find_all(str));
+	}
+	catch (const std::runtime_error &e)
+	{
+		context.warn(e.what());
+		context.stack.push(std::vector<Value>());
 	}
-
-	context.stack.push(values);
 }
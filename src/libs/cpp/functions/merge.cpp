@@ -3,7 +3,7 @@
 void merge(Context &context) noexcept
 {
 	// Concatenate two arrays
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto array1 = params[0].to_array();
 	auto array2 = params[1].to_array();
 
@@ -3,16 +3,16 @@
 
 void min(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
 	bool found_value = false;
 	double result = std::numeric_limits<double>::max();
 
 	for (const Value &value : params)
 	{
-		if (std::holds_alternative<std::vector<Value>>(value))
+		if (std::holds_alternative<Array>(value))
 		{
-			for (const Value &inner_value : std::get<std::vector<Value>>(value))
+			for (const Value &inner_value : std::get<Array>(value))
 			{
 				result = std::min(result, inner_value.to_number());
 				found_value = true;
@@ -3,7 +3,7 @@
 void modf(Context &context) noexcept
 {
 	// Split a floating point number into its integer and fractional parts.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double number = params[0].to_number();
 
 	double intpart;
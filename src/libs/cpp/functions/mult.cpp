@@ -2,13 +2,13 @@
 
 void mult(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double total = 1;
 	for (const Value &value : params)
 	{
-		if (std::holds_alternative<std::vector<Value>>(value))
+		if (std::holds_alternative<Array>(value))
 		{
-			for (const Value &inner_value : std::get<std::vector<Value>>(value))
+			for (const Value &inner_value : std::get<Array>(value))
 			{
 				total *= inner_value.to_number();
 				if (total == 0)
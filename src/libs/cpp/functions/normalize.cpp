@@ -3,7 +3,7 @@
 
 void normalize(Context &context) noexcept
 {
-	auto vector = std::get<std::vector<Value>>(context.stack.pop())[0].to_array();
+	auto vector = context.args()[0].to_array();
 
 	double length = 0;
 	for (const auto &value : vector)
@@ -3,17 +3,17 @@
 void object(Context &context) noexcept
 {
 	// Fold an array into an object.
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 
-	if (!std::holds_alternative<std::vector<Value>>(value))
+	if (!std::holds_alternative<Array>(value))
 	{
 		// If the value is not an array, return an empty object.
-		context.stack.push(std::map<std::string, Value>());
+		context.stack.push(ObjectData());
 		return;
 	}
 
-	auto array = std::get<std::vector<Value>>(value);
-	std::map<std::string, Value> object;
+	auto array = std::get<Array>(value);
+	ObjectData object;
 
 	for (size_t i = 0; i < array.size(); i += 2)
 	{
@@ -3,7 +3,7 @@
 void random_element(Context &context) noexcept
 {
 	// Select a random element from a list.
-	auto list = std::get<std::vector<Value>>(context.stack.pop())[0].to_array();
+	auto list = context.args()[0].to_array();
 
 	if (list.empty())
 	{
@@ -3,7 +3,7 @@
 void random_elements(Context &context) noexcept
 {
 	// Select (non-repeating) random elements from a list.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto list = params[0].to_array();
 
 	if (list.empty())
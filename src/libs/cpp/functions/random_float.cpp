@@ -2,7 +2,7 @@
 
 void random_float(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double min = params[0].to_number();
 	double max = params[1].to_number();
 
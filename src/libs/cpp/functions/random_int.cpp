@@ -2,7 +2,7 @@
 
 void random_int(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	long min = params[0].to_number();
 	long max = params[1].to_number();
 
@@ -2,7 +2,7 @@
 
 void random_weighted(Context &context) noexcept
 {
-	auto args = std::get<std::vector<Value>>(context.stack.pop());
+	auto args = context.args();
 	auto array = args[0].to_array();
 	auto weights = args[1].to_array();
 
@@ -3,7 +3,7 @@
 void replace(Context &context) noexcept
 {
 	// Replace all occurrences of a substring in a string
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
 	auto str = params[0].to_string();
 	auto search = params[1].to_string();
@@ -4,11 +4,11 @@
 void reverse(Context &context) noexcept
 {
 	// Reverse an array or string
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 
-	if (std::holds_alternative<std::string>(value))
+	if (std::holds_alternative<String>(value))
 	{
-		auto str = std::get<std::string>(value);
+		auto str = std::get<String>(value).get();
 		std::reverse(str.begin(), str.end());
 		context.stack.push(str);
 	}
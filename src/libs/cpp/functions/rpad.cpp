@@ -3,7 +3,7 @@
 void rpad(Context &context) noexcept
 {
 	// Right pad a string
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
 	auto str = params[0].to_string();
 	auto pad = params[1].to_string();
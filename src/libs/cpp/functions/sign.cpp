@@ -3,6 +3,6 @@
 void sign(Context &context) noexcept
 {
 	// Sign of a number.
-	auto param = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto param = context.args()[0];
 	context.stack.push(std::signbit(param.to_number()) ? -1 : 1);
 }
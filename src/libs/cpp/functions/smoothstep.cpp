@@ -3,7 +3,7 @@
 void smoothstep(Context &context) noexcept
 {
 	// Smoothstep interpolation between two values.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double x = params[0].to_number();
 	double min = params[1].to_number();
 	double max = params[2].to_number();
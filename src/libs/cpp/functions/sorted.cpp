@@ -4,9 +4,9 @@
 void sorted(Context &context) noexcept
 {
 	// Check if an array is sorted in ascending order.
-	auto param = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto param = context.args()[0];
 
-	if (!std::holds_alternative<std::vector<Value>>(param))
+	if (!std::holds_alternative<Array>(param))
 	{
 		context.stack.push(false);
 		return;
@@ -3,7 +3,7 @@
 void splice(Context &context) noexcept
 {
 	// Splice an array.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto list = params[0].to_array();
 	int start = params[1].to_number();
 	int end = params[2].to_number();
@@ -2,7 +2,7 @@
 
 void split(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto str = params[0].to_string();
 	auto delimiter = params[1].to_string();
 
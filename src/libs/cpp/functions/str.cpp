@@ -2,6 +2,6 @@
 
 void str(Context &context) noexcept
 {
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 	context.stack.push(value.to_string());
 }
@@ -6,6 +6,16 @@ void strlike(Context &context) noexcept
 	auto pattern = context.stack.pop().to_string();
 	auto data = context.stack.pop().to_string();
 
-	auto values = lua_match(data, pattern);
-	context.stack.push(values.size() > 0);
+	bool result = false;
+	try
+	{
+		LuaMatch match;
+		result = lua_pattern(pattern)->find(data, 0, match);
+	}
+	catch (const std::runtime_error &e)
+	{
+		context.warn(e.what());
+	}
+
+	context.stack.push(result);
 }
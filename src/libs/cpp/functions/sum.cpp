@@ -2,13 +2,20 @@
 
 void sum(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double total = 0;
 	for (const Value &value : params)
 	{
-		if (std::holds_alternative<std::vector<Value>>(value))
+		if (std::holds_alternative<Array>(value) && std::get<Array>(value).raw().is_range())
 		{
-			for (const Value &inner_value : std::get<std::vector<Value>>(value))
+			// Sum of an arithmetic series, without filling in the range.
+			const auto &range = std::get<Array>(value).raw();
+			const double count = range.length();
+			total += count * range.range_first() + count * (count - 1) / 2;
+		}
+		else if (std::holds_alternative<Array>(value))
+		{
+			for (const Value &inner_value : std::get<Array>(value))
 			{
 				total += inner_value.to_number();
 			}
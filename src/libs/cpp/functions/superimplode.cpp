@@ -7,9 +7,9 @@ void superimplode(Context &context) noexcept
 	for (int i = 0; i < context.arg; i++)
 	{
 		auto item = context.stack.pop();
-		if (std::holds_alternative<std::vector<Value>>(item))
+		if (std::holds_alternative<Array>(item))
 		{
-			auto subset = std::get<std::vector<Value>>(item);
+			auto subset = std::get<Array>(item).get();
 			std::reverse(subset.begin(), subset.end());
 			for (const Value &value : subset)
 			{
@@ -1,27 +1,30 @@
 #include "symmetric_difference.hpp"
-#include <algorithm>
+#include <unordered_set>
 
 void symmetric_difference(Context &context) noexcept
 {
 	// Find the symmetric difference of two arrays.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]) && std::holds_alternative<std::vector<Value>>(params[1]))
+	if (std::holds_alternative<Array>(params[0]) && std::holds_alternative<Array>(params[1]))
 	{
-		auto array1 = std::get<std::vector<Value>>(params[0]);
-		auto array2 = std::get<std::vector<Value>>(params[1]);
+		auto array1 = std::get<Array>(params[0]);
+		auto array2 = std::get<Array>(params[1]);
+
+		const std::unordered_set<Value> lookup1(array1.begin(), array1.end());
+		const std::unordered_set<Value> lookup2(array2.begin(), array2.end());
 
 		std::vector<Value> result;
 		for (const Value &value : array1)
 		{
-			if (std::find(array2.begin(), array2.end(), value) == array2.end())
+			if (!lookup2.count(value))
 			{
 				result.push_back(value);
 			}
 		}
 		for (const Value &value : array2)
 		{
-			if (std::find(array1.begin(), array1.end(), value) == array1.end())
+			if (!lookup1.count(value))
 			{
 				result.push_back(value);
 			}
@@ -33,11 +36,11 @@ void symmetric_difference(Context &context) noexcept
 	{
 		context.warn("Symmetric difference requires two arrays. Result may be unexpected.");
 
-		if (std::holds_alternative<std::vector<Value>>(params[0]))
+		if (std::holds_alternative<Array>(params[0]))
 		{
 			context.stack.push(params[0]);
 		}
-		else if (std::holds_alternative<std::vector<Value>>(params[1]))
+		else if (std::holds_alternative<Array>(params[1]))
 		{
 			context.stack.push(params[1]);
 		}
@@ -3,6 +3,6 @@
 void tanh(Context &context) noexcept
 {
 	// Hyperbolic tangent of a number.
-	auto param = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto param = context.args()[0];
 	context.stack.push(std::tanh(param.to_number()));
 }
@@ -21,12 +21,12 @@ void time(Context &context) noexcept
 {
 	// Convert a number or array representation of a time (sefonds since midnight OR [hour, min, sec, milli]) into an ISO compliant time string.
 
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	std::string result;
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]))
+	if (std::holds_alternative<Array>(params[0]))
 	{
-		auto time = std::get<std::vector<Value>>(params[0]);
+		auto time = std::get<Array>(params[0]);
 		if (time.size() >= 3)
 		{
 			int hour = time[0].to_number();
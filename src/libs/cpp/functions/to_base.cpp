@@ -4,7 +4,7 @@
 void to_base(Context &context) noexcept
 {
 	// Convert a number to a string of any base.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	double number = params[0].to_number();
 	int base = params[1].to_number();
 	int pad_width = params[2].to_number();
@@ -3,7 +3,7 @@
 
 void toepoch(Context &context) noexcept
 {
-	auto datetime = std::get<std::vector<Value>>(context.stack.pop())[0].to_object();
+	auto datetime = context.args()[0].to_object();
 	const auto dateobj = datetime["date"].to_array();
 	const auto timeobj = datetime["time"].to_array();
 
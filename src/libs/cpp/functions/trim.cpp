@@ -3,7 +3,7 @@
 
 void trim(Context &context) noexcept
 {
-	auto values = std::get<std::vector<Value>>(context.stack.pop());
+	auto values = context.args();
 	auto text = values[0].to_string();
 	auto chars = values[1].to_string();
 
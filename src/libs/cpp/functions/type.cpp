@@ -2,9 +2,9 @@
 
 void type(Context &context) noexcept
 {
-	auto data = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto data = context.args()[0];
 
-	if (std::holds_alternative<std::string>(data))
+	if (std::holds_alternative<String>(data))
 	{
 		context.stack.push("string");
 	}
@@ -16,11 +16,11 @@ void type(Context &context) noexcept
 	{
 		context.stack.push("boolean");
 	}
-	else if (std::holds_alternative<std::vector<Value>>(data))
+	else if (std::holds_alternative<Array>(data))
 	{
 		context.stack.push("array");
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(data))
+	else if (std::holds_alternative<Object>(data))
 	{
 		context.stack.push("object");
 	}
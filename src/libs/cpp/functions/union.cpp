@@ -1,27 +1,30 @@
 #include "union.hpp"
-#include <algorithm>
+#include <unordered_set>
 
 void _union(Context &context) noexcept
 {
 	// Combine two arrays into one, removing duplicates.
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 
-	if (std::holds_alternative<std::vector<Value>>(params[0]) && std::holds_alternative<std::vector<Value>>(params[1]))
+	if (std::holds_alternative<Array>(params[0]) && std::holds_alternative<Array>(params[1]))
 	{
-		auto array1 = std::get<std::vector<Value>>(params[0]);
-		auto array2 = std::get<std::vector<Value>>(params[1]);
+		auto array1 = std::get<Array>(params[0]);
+		auto array2 = std::get<Array>(params[1]);
 
 		std::vector<Value> result;
+		std::unordered_set<Value> seen;
+		seen.reserve(array1.size() + array2.size());
+
 		for (const Value &value : array1)
 		{
-			if (std::find(result.begin(), result.end(), value) == result.end())
+			if (seen.insert(value).second)
 			{
 				result.push_back(value);
 			}
 		}
 		for (const Value &value : array2)
 		{
-			if (std::find(result.begin(), result.end(), value) == result.end())
+			if (seen.insert(value).second)
 			{
 				result.push_back(value);
 			}
@@ -33,11 +36,11 @@ void _union(Context &context) noexcept
 	{
 		context.warn("Union requires two arrays. Result may be unexpected.");
 
-		if (std::holds_alternative<std::vector<Value>>(params[0]))
+		if (std::holds_alternative<Array>(params[0]))
 		{
 			context.stack.push(params[0]);
 		}
-		else if (std::holds_alternative<std::vector<Value>>(params[1]))
+		else if (std::holds_alternative<Array>(params[1]))
 		{
 			context.stack.push(params[1]);
 		}
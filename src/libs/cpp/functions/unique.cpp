@@ -1,15 +1,17 @@
 #include "unique.hpp"
-#include <algorithm>
+#include <unordered_set>
 
 void unique(Context &context) noexcept
 {
 	// Remove duplicate values from an array.
-	auto array = std::get<std::vector<Value>>(context.stack.pop())[0].to_array();
+	auto array = context.args()[0].to_array();
 	std::vector<Value> result;
+	std::unordered_set<Value> seen;
+	seen.reserve(array.size());
 
 	for (const Value &value : array)
 	{
-		if (std::find(result.begin(), result.end(), value) == result.end())
+		if (seen.insert(value).second)
 		{
 			result.push_back(value);
 		}
@@ -8,7 +8,7 @@ static std::uniform_int_distribution<> dis2(8, 11);
 
 void uuid(Context &context) noexcept
 {
-	context.stack.pop_back(); // Pop the params (always empty)
+	context.args(); // Pop the params (always empty)
 
 	// Generate a new UUID
 	std::stringstream ss;
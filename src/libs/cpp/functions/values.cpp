@@ -3,22 +3,22 @@
 void values(Context &context) noexcept
 {
 	// Get the values of an object or array.
-	auto value = std::get<std::vector<Value>>(context.stack.pop())[0];
+	auto value = context.args()[0];
 
 	std::vector<Value> values;
 
-	if (std::holds_alternative<std::vector<Value>>(value))
+	if (std::holds_alternative<Array>(value))
 	{
-		auto array = std::get<std::vector<Value>>(value);
+		auto array = std::get<Array>(value);
 
 		for (auto &i : array)
 		{
 			values.push_back(i);
 		}
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(value))
+	else if (std::holds_alternative<Object>(value))
 	{
-		auto object = std::get<std::map<std::string, Value>>(value);
+		auto object = std::get<Object>(value);
 
 		for (const auto &pair : object)
 		{
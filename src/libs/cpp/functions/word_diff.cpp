@@ -48,7 +48,7 @@ int levenschtein(const std::string &word1, const std::string &word2, int max) no
 
 void word_diff(Context &context) noexcept
 {
-	auto params = std::get<std::vector<Value>>(context.stack.pop());
+	auto params = context.args();
 	auto word1 = params[0].to_string();
 	auto word2 = params[1].to_string();
 
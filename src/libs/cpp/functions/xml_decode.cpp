@@ -340,7 +340,7 @@ std::tuple<std::vector<Entity>, Entity> pop_until(std::vector<Entity> &stack, co
 
 Value entity_to_object(const Entity &entity)
 {
-	std::map<std::string, Value> obj;
+	ObjectData obj;
 
 	obj["type"] = entity.type;
 	if (entity.value != "")
@@ -348,7 +348,7 @@ Value entity_to_object(const Entity &entity)
 		obj["value"] = entity.value;
 	}
 
-	std::map<std::string, Value> attributes;
+	ObjectData attributes;
 	for (const auto &[key, value] : entity.attributes)
 	{
 		attributes[key] = value;
@@ -371,7 +371,7 @@ Value entity_to_object(const Entity &entity)
 
 void xml_decode(Context &context) noexcept
 {
-	auto xml = std::get<std::vector<Value>>(context.stack.pop())[0].to_string();
+	auto xml = context.args()[0].to_string();
 
 	auto tokenizer = tokenize(xml);
 	auto entities = parseTokens(tokenizer);
@@ -2,7 +2,7 @@
 #include <algorithm>
 #include "../replace.hpp"
 
-Value get(const std::map<std::string, Value> &map, const std::string &key)
+Value get(const ObjectData &map, const std::string &key)
 {
 	auto iter = map.find(key);
 	if (iter == map.end())
@@ -35,12 +35,12 @@ std::string stringify_recursive(const Value &obj, int indent)
 {
 	std::string str = std::string(indent, ' ');
 
-	if (!std::holds_alternative<std::map<std::string, Value>>(obj))
+	if (!std::holds_alternative<Object>(obj))
 	{
 		return str + obj.to_string();
 	}
 
-	const auto &t = std::get<std::map<std::string, Value>>(obj);
+	const auto &t = std::get<Object>(obj);
 	const auto type = get(t, "type").to_string();
 
 	if (type == "text")
@@ -101,7 +101,7 @@ std::string stringify_recursive(const Value &obj, int indent)
 
 void xml_encode(Context &context) noexcept
 {
-	auto ast = std::get<std::vector<Value>>(context.stack.pop())[0].to_array();
+	auto ast = context.args()[0].to_array();
 
 	std::string result = "";
 	bool first = true;
@@ -1,8 +1,65 @@
 #pragma once
 
+// Opcodes, in the same order as the `bc` table in codegen.lua.
+enum Opcode : unsigned char
+{
+	OP_CALL = 1,
+	OP_SET,
+	OP_GET,
+	OP_PUSH,
+	OP_POP,
+	OP_RUN_COMMAND,
+	OP_PUSH_CMD_RESULT,
+	OP_PUSH_INDEX,
+	OP_POP_GOTO_INDEX,
+	OP_COPY,
+	OP_DELETE_VAR,
+	OP_SWAP,
+	OP_POP_UNTIL_NULL,
+	OP_GET_CACHE_ELSE_JUMP,
+	OP_SET_CACHE,
+	OP_DELETE_CACHE,
+	OP_PUSH_CATCH_LOC,
+	OP_VARIABLE_INSERT,
+	OP_DESTRUCTURE,
+	OP_GET_EXCEPTION_TYPE,
+	OP_PUSH_EXCEPTION,
+	OP_THROW_EXCEPTION,
+
+	// C++-only opcodes. STANDALONE.cpp.generate lowers the equivalent
+	// `call` instructions into these, so they never appear in Lua bytecode.
+	OP_JUMP,
+	OP_JUMP_IF_FALSE,
+	OP_JUMP_IF_NIL,
+	OP_CALL_ARGS,
+
+	// Superinstructions, fused from pairs of instructions by STANDALONE.cpp.fuse.
+	// Variable names are resolved to slots when the program is loaded.
+	OP_GET_GET,           // get x; get y
+	OP_GET_PUSH,          // get x; push c
+	OP_PUSH_GET,          // push c; get x
+	OP_PUSH_PUSH,         // push c; push d
+	OP_SET_GET,           // set x; get y
+	OP_CALL_SET,          // call F; set x
+	OP_POP_JUMP_IF_FALSE, // jump_if_false L; pop (jumps past the pop at L)
+	OP_JUMP_IF_NIL_SET,   // jump_if_nil L; set x
+
+	// Loop iterators. STANDALONE.cpp.lower rewrites `for` loops over an exploded array into these,
+	// so that each pass takes one element instead of the whole array being pushed up front.
+	OP_ITER_BEGIN,    // call explode, at the start of a loop
+	OP_ITER_NEXT,     // jump_if_nil L, at the top of a loop
+	OP_ITER_NEXT_SET, // iter_next L; set x
+
+	OP_SLICE, // call arrayslice; call arrayindex
+};
+
+// Instructions are packed into 8 bytes, so that the instruction stream stays small.
+// Line numbers are kept in a separate table (see VirtualMachine::line_number),
+// since they're only needed for warnings and errors.
 struct Instruction
 {
-	unsigned char opcode;
-	int line_no;
-	int operand[2];
+	unsigned int opcode : 8;
+	int operand0 : 24;
+	int operand1;
 };
+static_assert(sizeof(Instruction) == 8, "Instructions should be packed into 8 bytes");
@@ -0,0 +1,32 @@
+#include "intern.hpp"
+
+#include <string_view>
+#include <unordered_map>
+
+// Keyed by views of the interned strings themselves, which never move or get freed.
+static std::unordered_map<std::string_view, String> &strings() noexcept
+{
+	static std::unordered_map<std::string_view, String> table;
+	return table;
+}
+
+String intern(const std::string &text)
+{
+	auto &table = strings();
+	const auto it = table.find(text);
+	if (it != table.end())
+	{
+		return it->second;
+	}
+
+	String result(text);
+	table.emplace(result.raw(), result);
+	return result;
+}
+
+bool is_interned(const String &text) noexcept
+{
+	const auto &table = strings();
+	const auto it = table.find(text.raw());
+	return it != table.end() && &it->second.raw() == &text.raw();
+}
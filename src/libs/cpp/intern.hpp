@@ -0,0 +1,12 @@
+#pragma once
+
+#include "value.hpp"
+
+// Interned strings: a single shared copy of each distinct string that the program itself contains
+// (constants, and so variable names). Since there's only one copy of each, an interned string
+// can be recognised by the address of its contents, without comparing or hashing the text.
+// Interned strings are never freed, so strings built at run time shouldn't be interned.
+String intern(const std::string &text);
+
+// Whether this is the interned copy of its text.
+bool is_interned(const String &text) noexcept;
@@ -0,0 +1,154 @@
+#include "loader.hpp"
+#include "functions/file_glob.hpp"
+#include "functions/file_exists.hpp"
+#include "functions/file_size.hpp"
+#include "functions/file_read.hpp"
+#include "functions/file_write.hpp"
+#include "functions/file_append.hpp"
+#include "functions/file_delete.hpp"
+#include "functions/dir_create.hpp"
+#include "functions/dir_list.hpp"
+#include "functions/dir_delete.hpp"
+#include "functions/file_type.hpp"
+#include "functions/file_stat.hpp"
+#include "functions/file_copy.hpp"
+#include "functions/file_move.hpp"
+#include "functions/cmd_spawn.hpp"
+#include "functions/cmd_await.hpp"
+#include "functions/cmd_await_any.hpp"
+#include "functions/cmd_await_all.hpp"
+#include "functions/cmd_lines.hpp"
+#include "functions/cmd_pipe.hpp"
+
+// Get the slot for a variable that is being read.
+// Special variables are read-only, so they get their own (negative) ids.
+static int read_slot(VirtualMachine &vm, int name_id) noexcept
+{
+	const auto var_name = vm.get_const(name_id).to_string();
+
+	if (var_name == "@")
+	{
+		return VAR_PARAMS;
+	}
+	else if (var_name == "$")
+	{
+		return VAR_COMMANDS;
+	}
+	else if (var_name == "_VARS")
+	{
+		return VAR_VARS;
+	}
+	else if (var_name == "_VERSION")
+	{
+		return VAR_VERSION;
+	}
+
+	return vm.variables.slot(var_name);
+}
+
+// Get the slot for a variable that is being written or deleted.
+static int write_slot(VirtualMachine &vm, int name_id) noexcept
+{
+	return vm.variables.slot(vm.get_const(name_id).to_string());
+}
+
+// Resolve variable names to slot numbers.
+// For get/set/delete, the slot is stored in the (otherwise unused) second operand.
+// Superinstructions have no spare operand, so the name is replaced with the slot.
+// Constants pushed by superinstructions are also checked here, so they don't have to be checked at run time.
+static void resolve_variables(VirtualMachine &vm) noexcept
+{
+	for (auto &instruction : vm.instructions)
+	{
+		switch (instruction.opcode)
+		{
+		case OP_GET:
+			instruction.operand1 = read_slot(vm, instruction.operand0);
+			break;
+		case OP_SET:
+		case OP_DELETE_VAR:
+			instruction.operand1 = write_slot(vm, instruction.operand0);
+			break;
+		case OP_GET_GET:
+			instruction.operand0 = read_slot(vm, instruction.operand0);
+			instruction.operand1 = read_slot(vm, instruction.operand1);
+			break;
+		case OP_GET_PUSH:
+			instruction.operand0 = read_slot(vm, instruction.operand0);
+			vm.get_const(instruction.operand1);
+			break;
+		case OP_PUSH_GET:
+			vm.get_const(instruction.operand0);
+			instruction.operand1 = read_slot(vm, instruction.operand1);
+			break;
+		case OP_PUSH_PUSH:
+			vm.get_const(instruction.operand0);
+			vm.get_const(instruction.operand1);
+			break;
+		case OP_SET_GET:
+			instruction.operand0 = write_slot(vm, instruction.operand0);
+			instruction.operand1 = read_slot(vm, instruction.operand1);
+			break;
+		case OP_CALL_SET:
+		case OP_JUMP_IF_NIL_SET:
+		case OP_ITER_NEXT_SET:
+			instruction.operand1 = write_slot(vm, instruction.operand1);
+			break;
+		}
+	}
+}
+
+// Look up the builtin function for each call instruction.
+// Invalid and forbidden calls are rejected here, so the call action doesn't have to check for them.
+static void resolve_calls(VirtualMachine &vm) noexcept
+{
+	vm.call_table.assign(vm.instructions.size(), nullptr);
+
+	for (size_t i = 0; i < vm.instructions.size(); i++)
+	{
+		const auto &instruction = vm.instructions[i];
+		if (instruction.opcode != OP_CALL && instruction.opcode != OP_CALL_ARGS && instruction.opcode != OP_CALL_SET)
+		{
+			continue;
+		}
+
+		if (instruction.operand0 < 0 || instruction.operand0 >= FUNCTION_COUNT)
+		{
+			vm.error("Invalid function index");
+		}
+
+		const auto function = FUNCTIONS[instruction.operand0];
+		if (vm.sandboxed &&
+			(function == file_glob ||
+			 function == file_exists ||
+			 function == file_size ||
+			 function == file_read ||
+			 function == file_write ||
+			 function == file_append ||
+			 function == file_delete ||
+			 function == dir_create ||
+			 function == dir_list ||
+			 function == dir_delete ||
+			 function == file_type ||
+			 function == file_stat ||
+			 function == file_copy ||
+			 function == file_move ||
+			 function == cmd_spawn ||
+			 function == cmd_await ||
+			 function == cmd_await_any ||
+			 function == cmd_await_all ||
+			 function == cmd_lines ||
+			 function == cmd_pipe))
+		{
+			vm.error("File and process operations are not allowed in sandboxed mode!\nYou should never see this message, so one of two things is happening:\n1. There's a bug in the Paisley C++ runtime (in which case, please report it!)\n2. You're poking around in the runtime internals! You hacker :)");
+		}
+
+		vm.call_table[i] = function;
+	}
+}
+
+void load(VirtualMachine &vm) noexcept
+{
+	resolve_variables(vm);
+	resolve_calls(vm);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "virtual_machine.hpp"
+
+// Resolve everything in the loaded program that doesn't depend on run-time state,
+// so that the actions don't have to repeat that work every time they're executed.
+void load(VirtualMachine &vm) noexcept;
@@ -1,5 +1,7 @@
 #include "virtual_machine.hpp"
-#include "actions.hpp"
+#include "dispatch.hpp"
+#include "loader.hpp"
+#include "profile.hpp"
 #include "PAISLEY_BYTECODE.hpp"
 
 #include <iostream>
@@ -25,10 +27,13 @@ int main(int argc, char *argv[])
 		0,
 
 		// Instructions
-		INSTRUCTIONS,
+		std::move(INSTRUCTIONS),
+
+		// Line numbers
+		LINE_NUMBERS,
 
 		// Constant lookup table
-		CONSTANTS,
+		ConstantPool(CONSTANT_DATA, CONSTANT_OFFSETS, CONSTANT_COUNT),
 
 		// Whether the VM is sandboxed
 		SANDBOXED,
@@ -50,6 +55,9 @@ int main(int argc, char *argv[])
 
 		// Command-line arguments
 		{},
+
+		// Call table
+		{},
 	};
 
 	// Fill in command-line arguments
@@ -61,21 +69,19 @@ int main(int argc, char *argv[])
 
 	vm.rng.seed(std::random_device()());
 
-	while (vm.instruction_index < vm.instructions.size())
+	load(vm);
+	if (NATIVE_PROGRAM)
 	{
-		auto &instruction = vm.instructions[vm.instruction_index];
-
-		size_t opcode = instruction.opcode - 1;
-		if (opcode > OPERATION_COUNT)
-		{
-			vm.error("Invalid opcode: " + std::to_string(instruction.opcode));
-			break;
-		}
-
-		OPERATIONS[opcode](vm);
-
-		vm.instruction_index++;
+		NATIVE_PROGRAM(vm);
+	}
+	else
+	{
+		run(vm);
 	}
 
+#ifdef PAISLEY_PROFILE
+	profile_caches(vm);
+#endif
+
 	return 0;
 }
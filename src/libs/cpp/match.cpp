@@ -1,94 +1,664 @@
 #include "match.hpp"
-#include <regex>
 
-std::regex lua_pattern_to_regex(const std::string &pattern)
+#include <cctype>
+#include <cstring>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+
+// The matcher is a port of Lua 5.4's lstrlib.c, so that patterns behave exactly as they do in the Lua runtime.
+
+static const char L_ESC = '%';
+static const char *const SPECIALS = "^$*+?.([%-";
+
+static const int MAX_CAPTURES = 32;
+static const int MAX_CALLS = 200;
+
+static const ptrdiff_t CAP_UNFINISHED = -1;
+static const ptrdiff_t CAP_POSITION = -2;
+
+// Markers in LuaPattern::class_end for classes that are malformed.
+static const size_t ENDS_WITH_ESCAPE = static_cast<size_t>(-1);
+static const size_t MISSING_BRACKET = static_cast<size_t>(-2);
+
+static inline int uchar(char c)
+{
+	return static_cast<unsigned char>(c);
+}
+
+// Find the end of the single-character class starting at `p`, without checking the precomputed table.
+static size_t scan_class_end(const std::string &text, size_t p)
 {
-	std::string re;
-	re.reserve(pattern.size() * 2); // Reserve enough space to avoid frequent reallocations
+	const size_t end = text.size();
 
-	for (size_t i = 0; i < pattern.size(); ++i)
+	switch (text[p++])
 	{
-		char c = pattern[i];
-		switch (c)
+	case L_ESC:
+		if (p == end)
+		{
+			return ENDS_WITH_ESCAPE;
+		}
+		return p + 1;
+	case '[':
+		if (text[p] == '^')
+		{
+			p++;
+		}
+		// Look for a ']'
+		do
 		{
-		case '%':
-			if (i + 1 < pattern.size())
+			if (p >= end)
+			{
+				return MISSING_BRACKET;
+			}
+			if (text[p++] == L_ESC && p < end)
 			{
-				char next = pattern[++i];
-				switch (next)
+				// Skip escapes (e.g. '%]')
+				p++;
+			}
+		} while (text[p] != ']');
+		return p + 1;
+	default:
+		return p;
+	}
+}
+
+static bool match_class(int c, int cl)
+{
+	bool result;
+	switch (std::tolower(cl))
+	{
+	case 'a':
+		result = std::isalpha(c);
+		break;
+	case 'c':
+		result = std::iscntrl(c);
+		break;
+	case 'd':
+		result = std::isdigit(c);
+		break;
+	case 'g':
+		result = std::isgraph(c);
+		break;
+	case 'l':
+		result = std::islower(c);
+		break;
+	case 'p':
+		result = std::ispunct(c);
+		break;
+	case 's':
+		result = std::isspace(c);
+		break;
+	case 'u':
+		result = std::isupper(c);
+		break;
+	case 'w':
+		result = std::isalnum(c);
+		break;
+	case 'x':
+		result = std::isxdigit(c);
+		break;
+	case 'z':
+		// Deprecated in Lua, but still supported.
+		result = (c == 0);
+		break;
+	default:
+		return cl == c;
+	}
+
+	return std::isupper(cl) ? !result : result;
+}
+
+// Check `c` against the bracket class from `p` ('[') to `ec` (']').
+static bool match_bracket_class(int c, const char *p, const char *ec)
+{
+	bool sig = true;
+	if (*(p + 1) == '^')
+	{
+		sig = false;
+		p++;
+	}
+
+	while (++p < ec)
+	{
+		if (*p == L_ESC)
+		{
+			p++;
+			if (match_class(c, uchar(*p)))
+			{
+				return sig;
+			}
+		}
+		else if (*(p + 1) == '-' && p + 2 < ec)
+		{
+			p += 2;
+			if (uchar(*(p - 2)) <= c && c <= uchar(*p))
+			{
+				return sig;
+			}
+		}
+		else if (uchar(*p) == c)
+		{
+			return sig;
+		}
+	}
+
+	return !sig;
+}
+
+struct MatchState
+{
+	const LuaPattern &pattern;
+	const char *src_init;
+	const char *src_end;
+	const char *p_init;
+	const char *p_end;
+	int matchdepth;
+	int level;
+
+	struct
+	{
+		const char *init;
+		ptrdiff_t len;
+	} capture[MAX_CAPTURES];
+
+	MatchState(const LuaPattern &pattern, std::string_view subject) noexcept
+		: pattern(pattern),
+		  src_init(subject.data()),
+		  src_end(subject.data() + subject.size()),
+		  p_init(pattern.text.data()),
+		  p_end(pattern.text.data() + pattern.text.size()),
+		  matchdepth(MAX_CALLS),
+		  level(0)
+	{
+	}
+
+	void reset() noexcept
+	{
+		level = 0;
+		matchdepth = MAX_CALLS;
+	}
+
+	const char *class_end(const char *p) const
+	{
+		const size_t end = pattern.class_end[p - p_init];
+		if (end == ENDS_WITH_ESCAPE)
+		{
+			throw std::runtime_error("malformed pattern (ends with '%')");
+		}
+		if (end == MISSING_BRACKET)
+		{
+			throw std::runtime_error("malformed pattern (missing ']')");
+		}
+		return p_init + end;
+	}
+
+	bool single_match(const char *s, const char *p, const char *ep) const
+	{
+		if (s >= src_end)
+		{
+			return false;
+		}
+
+		const int c = uchar(*s);
+		switch (*p)
+		{
+		case '.':
+			return true;
+		case L_ESC:
+			return match_class(c, uchar(*(p + 1)));
+		case '[':
+			return match_bracket_class(c, p, ep - 1);
+		default:
+			return uchar(*p) == c;
+		}
+	}
+
+	const char *match_balance(const char *s, const char *p) const
+	{
+		if (p >= p_end - 1)
+		{
+			throw std::runtime_error("malformed pattern (missing arguments to '%b')");
+		}
+
+		if (*s != *p)
+		{
+			return nullptr;
+		}
+
+		const char b = *p;
+		const char e = *(p + 1);
+		int count = 1;
+		while (++s < src_end)
+		{
+			if (*s == e)
+			{
+				if (--count == 0)
 				{
-				case 'a':
-					re += "[A-Za-z]";
-					break;
-				case 'c':
-					re += "[\\x00-\\x1F\\x7F]";
-					break;
-				case 'd':
-					re += "\\d";
-					break;
-				case 'g':
-					re += "[\\x21-\\x7E]";
-					break;
-				case 'l':
-					re += "[a-z]";
-					break;
-				case 'p':
-					re += "[\\x21-\\x2F\\x3A-\\x40\\x5B-\\x60\\x7B-\\x7E]";
-					break;
-				case 's':
-					re += "\\s";
-					break;
-				case 'u':
-					re += "[A-Z]";
-					break;
-				case 'w':
-					re += "\\w";
-					break;
-				case 'x':
-					re += "[A-Fa-f0-9]";
+					return s + 1;
+				}
+			}
+			else if (*s == b)
+			{
+				count++;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const char *max_expand(const char *s, const char *p, const char *ep)
+	{
+		ptrdiff_t i = 0;
+		while (single_match(s + i, p, ep))
+		{
+			i++;
+		}
+
+		// Try with the maximum number of repetitions, then with one fewer each time.
+		while (i >= 0)
+		{
+			const char *result = match(s + i, ep + 1);
+			if (result)
+			{
+				return result;
+			}
+			i--;
+		}
+
+		return nullptr;
+	}
+
+	const char *min_expand(const char *s, const char *p, const char *ep)
+	{
+		for (;;)
+		{
+			const char *result = match(s, ep + 1);
+			if (result)
+			{
+				return result;
+			}
+			else if (single_match(s, p, ep))
+			{
+				s++;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+	}
+
+	const char *start_capture(const char *s, const char *p, ptrdiff_t what)
+	{
+		if (level >= MAX_CAPTURES)
+		{
+			throw std::runtime_error("too many captures");
+		}
+
+		capture[level].init = s;
+		capture[level].len = what;
+		level++;
+
+		const char *result = match(s, p);
+		if (!result)
+		{
+			level--;
+		}
+		return result;
+	}
+
+	const char *end_capture(const char *s, const char *p)
+	{
+		int l = -1;
+		for (int i = level - 1; i >= 0; i--)
+		{
+			if (capture[i].len == CAP_UNFINISHED)
+			{
+				l = i;
+				break;
+			}
+		}
+
+		if (l < 0)
+		{
+			throw std::runtime_error("invalid pattern capture");
+		}
+
+		capture[l].len = s - capture[l].init;
+		const char *result = match(s, p);
+		if (!result)
+		{
+			capture[l].len = CAP_UNFINISHED;
+		}
+		return result;
+	}
+
+	const char *match_capture(const char *s, int l) const
+	{
+		l -= '1';
+		if (l < 0 || l >= level || capture[l].len == CAP_UNFINISHED)
+		{
+			throw std::runtime_error("invalid capture index %" + std::to_string(l + 1));
+		}
+
+		const size_t len = capture[l].len;
+		if (static_cast<size_t>(src_end - s) >= len && std::memcmp(capture[l].init, s, len) == 0)
+		{
+			return s + len;
+		}
+		return nullptr;
+	}
+
+	const char *match(const char *s, const char *p)
+	{
+		if (matchdepth-- == 0)
+		{
+			throw std::runtime_error("pattern too complex");
+		}
+
+	init:
+		if (p != p_end)
+		{
+			switch (*p)
+			{
+			case '(':
+				if (*(p + 1) == ')')
+				{
+					s = start_capture(s, p + 2, CAP_POSITION);
+				}
+				else
+				{
+					s = start_capture(s, p + 1, CAP_UNFINISHED);
+				}
+				break;
+
+			case ')':
+				s = end_capture(s, p + 1);
+				break;
+
+			case '$':
+				// '$' is only an anchor at the end of the pattern.
+				if (p + 1 != p_end)
+				{
+					goto dflt;
+				}
+				s = (s == src_end) ? s : nullptr;
+				break;
+
+			case L_ESC:
+				switch (*(p + 1))
+				{
+				case 'b':
+					s = match_balance(s, p + 2);
+					if (s)
+					{
+						p += 4;
+						goto init;
+					}
 					break;
-				case 'z':
-					re += "\\x00";
+
+				case 'f':
+				{
+					p += 2;
+					if (*p != '[')
+					{
+						throw std::runtime_error("missing '[' after '%f' in pattern");
+					}
+
+					const char *ep = class_end(p);
+					const char previous = (s == src_init) ? '\0' : *(s - 1);
+					if (!match_bracket_class(uchar(previous), p, ep - 1) && match_bracket_class(uchar(*s), p, ep - 1))
+					{
+						p = ep;
+						goto init;
+					}
+					s = nullptr;
 					break;
-				case '%':
-					re += "%";
+				}
+
+				case '0':
+				case '1':
+				case '2':
+				case '3':
+				case '4':
+				case '5':
+				case '6':
+				case '7':
+				case '8':
+				case '9':
+					s = match_capture(s, uchar(*(p + 1)));
+					if (s)
+					{
+						p += 2;
+						goto init;
+					}
 					break;
+
 				default:
-					re += "\\" + std::string(1, next);
-					break;
+					goto dflt;
 				}
+				break;
+
+			default:
+			dflt:
+			{
+				const char *ep = class_end(p);
+
+				if (!single_match(s, p, ep))
+				{
+					// Accept empty?
+					if (*ep == '*' || *ep == '?' || *ep == '-')
+					{
+						p = ep + 1;
+						goto init;
+					}
+					s = nullptr;
+				}
+				else
+				{
+					switch (*ep)
+					{
+					case '?':
+					{
+						const char *result = match(s + 1, ep + 1);
+						if (result)
+						{
+							s = result;
+						}
+						else
+						{
+							p = ep + 1;
+							goto init;
+						}
+						break;
+					}
+					case '+':
+						s = max_expand(s + 1, p, ep);
+						break;
+					case '*':
+						s = max_expand(s, p, ep);
+						break;
+					case '-':
+						s = min_expand(s, p, ep);
+						break;
+					default:
+						s++;
+						p = ep;
+						goto init;
+					}
+				}
+				break;
 			}
-			break;
-		case '|':
-			re += "\\|";
-			break;
-		case '\\':
-			re += "\\\\";
-			break;
-		default:
-			re += c;
-			break;
+			}
+		}
+
+		matchdepth++;
+		return s;
+	}
+
+	Value get_capture(int i, const char *s, const char *e) const
+	{
+		if (i >= level)
+		{
+			if (i != 0)
+			{
+				throw std::runtime_error("invalid capture index %" + std::to_string(i + 1));
+			}
+			// No captures, so the whole match is the capture.
+			return std::string(s, e - s);
+		}
+
+		const ptrdiff_t len = capture[i].len;
+		if (len == CAP_UNFINISHED)
+		{
+			throw std::runtime_error("unfinished capture");
+		}
+		else if (len == CAP_POSITION)
+		{
+			return static_cast<double>(capture[i].init - src_init + 1);
+		}
+		return std::string(capture[i].init, len);
+	}
+
+	void get_captures(const char *s, const char *e, LuaMatch &result) const
+	{
+		const int count = (level == 0) ? 1 : level;
+		result.start = s - src_init;
+		result.end = e - src_init;
+		result.captures.clear();
+		result.captures.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			result.captures.push_back(get_capture(i, s, e));
 		}
 	}
+};
+
+LuaPattern::LuaPattern(const std::string &pattern)
+	: text(pattern),
+	  anchored(!pattern.empty() && pattern[0] == '^'),
+	  plain(pattern.find_first_of(SPECIALS) == std::string::npos),
+	  first_char(-1),
+	  class_end(pattern.size())
+{
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		class_end[i] = scan_class_end(text, i);
+	}
 
-	return std::regex(re);
+	// A plain character that isn't optional has to be the first character of every match.
+	const size_t first = anchored ? 1 : 0;
+	if (first < text.size() && !std::strchr(SPECIALS, text[first]))
+	{
+		const char next = text.c_str()[first + 1];
+		if (next != '*' && next != '?' && next != '-')
+		{
+			first_char = uchar(text[first]);
+		}
+	}
 }
 
-// Match patterns using Lua's pattern matching syntax.
-std::vector<std::string> lua_match(const std::string &str, const std::string &pattern)
+bool LuaPattern::find(std::string_view subject, size_t init, LuaMatch &match) const
 {
-	std::vector<std::string> values;
-	auto re = lua_pattern_to_regex(pattern);
-	std::smatch match;
+	if (init > subject.size())
+	{
+		return false;
+	}
+
+	if (plain)
+	{
+		const size_t start = subject.find(text, init);
+		if (start == std::string_view::npos)
+		{
+			return false;
+		}
+		match.start = start;
+		match.end = start + text.size();
+		match.captures.assign(1, text);
+		return true;
+	}
 
-	if (std::regex_match(str, match, re))
+	MatchState state(*this, subject);
+	const char *p = text.data() + (anchored ? 1 : 0);
+	const char *s = subject.data() + init;
+
+	do
 	{
-		values.reserve(match.size());
+		if (!anchored && first_char >= 0)
+		{
+			s = static_cast<const char *>(std::memchr(s, first_char, state.src_end - s));
+			if (!s)
+			{
+				return false;
+			}
+		}
 
-		for (size_t i = 0; i < match.size(); ++i)
+		state.reset();
+		const char *e = state.match(s, p);
+		if (e)
+		{
+			state.get_captures(s, e, match);
+			return true;
+		}
+	} while (s++ < state.src_end && !anchored);
+
+	return false;
+}
+
+std::vector<Value> LuaPattern::find_all(std::string_view subject) const
+{
+	std::vector<Value> result;
+	MatchState state(*this, subject);
+	LuaMatch match;
+
+	// Unlike find(), a '^' here is just a character, as in string.gmatch().
+	const char *last_match = nullptr;
+	for (const char *src = state.src_init; src <= state.src_end; src++)
+	{
+		state.reset();
+		const char *e = state.match(src, state.p_init);
+		if (e && e != last_match)
 		{
-			values.push_back(match[i].str());
+			state.get_captures(src, e, match);
+			result.push_back(std::move(match.captures[0]));
+
+			// Carry on from the end of this match.
+			// The loop increment is undone, since a non-empty match may be followed by another straight away.
+			last_match = e;
+			src = e - 1;
 		}
 	}
-	return values;
+
+	return result;
+}
+
+std::shared_ptr<const LuaPattern> lua_pattern(const std::string &pattern)
+{
+	static const size_t CAPACITY = 64;
+
+	// Most recently used first.
+	using Entry = std::pair<std::string, std::shared_ptr<const LuaPattern>>;
+	static std::list<Entry> recent;
+	static std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+
+	const auto found = lookup.find(pattern);
+	if (found != lookup.end())
+	{
+		recent.splice(recent.begin(), recent, found->second);
+		return found->second->second;
+	}
+
+	auto compiled = std::make_shared<const LuaPattern>(pattern);
+
+	recent.emplace_front(pattern, compiled);
+	lookup[pattern] = recent.begin();
+
+	if (recent.size() > CAPACITY)
+	{
+		lookup.erase(recent.back().first);
+		recent.pop_back();
+	}
+
+	return compiled;
 }
@@ -1,4 +1,57 @@
-#include <vector>
+#pragma once
+
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "value.hpp"
+
+// One match of a Lua pattern: where it is in the subject, and what it captured.
+// If the pattern has no captures, the whole match is the only capture.
+// Position captures, `()`, are numbers; all other captures are strings.
+struct LuaMatch
+{
+	size_t start;
+	size_t end;
+	std::vector<Value> captures;
+};
+
+// A Lua pattern, prepared for matching.
+// Matching works the same way as Lua 5.4's string library (lstrlib.c), including `%b`, `%f`,
+// anchors, back-references and position captures, so the results match the Lua runtime exactly.
+// Malformed patterns throw std::runtime_error, with the same message that Lua gives.
+class LuaPattern
+{
+public:
+	explicit LuaPattern(const std::string &pattern);
+
+	// Find the first match at or after `init`, like string.match().
+	// A `^` at the start of the pattern anchors it to `init`.
+	// The subject must be followed by a null character (as std::string data is).
+	bool find(std::string_view subject, size_t init, LuaMatch &match) const;
+
+	// Find every match, like string.gmatch(). Each element is the first capture of one match.
+	std::vector<Value> find_all(std::string_view subject) const;
+
+private:
+	friend struct MatchState;
+
+	std::string text;
+	bool anchored;
+
+	// If the pattern has no special characters, it's just found with std::string::find.
+	bool plain;
+
+	// If every match has to start with a certain character, the search can skip straight to it.
+	int first_char;
+
+	// For each position in the pattern, where the single-character class that starts there ends.
+	// Bracket classes are the expensive part of matching, so they're only scanned once.
+	std::vector<size_t> class_end;
+};
 
-std::vector<std::string> lua_match(const std::string &str, const std::string &pattern);
+// Get a prepared pattern. Recently used patterns are cached, since scripts
+// tend to use the same few patterns over and over again.
+std::shared_ptr<const LuaPattern> lua_pattern(const std::string &pattern);
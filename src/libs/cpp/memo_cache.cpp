@@ -0,0 +1,66 @@
+#include "memo_cache.hpp"
+
+std::list<MemoCache::Entry>::iterator MemoCache::lookup(size_t hash, const Value &params) noexcept
+{
+	auto range = index.equal_range(hash);
+	for (auto i = range.first; i != range.second; ++i)
+	{
+		if (i->second->params == params)
+		{
+			return i->second;
+		}
+	}
+	return entries.end();
+}
+
+const Value *MemoCache::find(const Value &params) noexcept
+{
+	auto entry = lookup(params.hash(), params);
+	if (entry == entries.end())
+	{
+		misses++;
+		return nullptr;
+	}
+
+	hits++;
+	entries.splice(entries.begin(), entries, entry);
+	return &entry->result;
+}
+
+void MemoCache::insert(const Value &params, const Value &result) noexcept
+{
+	const size_t hash = params.hash();
+
+	// A recursive call with the same parameters may have stored a result already.
+	auto entry = lookup(hash, params);
+	if (entry != entries.end())
+	{
+		entry->result = result;
+		entries.splice(entries.begin(), entries, entry);
+		return;
+	}
+
+	entries.push_front({hash, params, result});
+	index.emplace(hash, entries.begin());
+
+	while (entries.size() > capacity)
+	{
+		auto oldest = std::prev(entries.end());
+		auto range = index.equal_range(oldest->hash);
+		for (auto i = range.first; i != range.second; ++i)
+		{
+			if (i->second == oldest)
+			{
+				index.erase(i);
+				break;
+			}
+		}
+		entries.pop_back();
+	}
+}
+
+void MemoCache::clear() noexcept
+{
+	entries.clear();
+	index.clear();
+}
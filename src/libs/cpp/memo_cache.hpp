@@ -0,0 +1,48 @@
+#pragma once
+
+#include "value.hpp"
+#include <list>
+#include <unordered_map>
+
+// The default number of results kept for each memoized (`cache`) subroutine.
+// A subroutine can set its own limit with a `#@cache_size` annotation.
+#ifndef PAISLEY_CACHE_SIZE
+#define PAISLEY_CACHE_SIZE 65536
+#endif
+
+// The results of a memoized subroutine, keyed by the parameters it was called with.
+// Parameters are looked up by their hash, and only compared in full when the hashes match.
+// When the cache is full, the least recently used result is dropped.
+class MemoCache
+{
+public:
+	size_t capacity = PAISLEY_CACHE_SIZE;
+
+	// Lookups that did and did not find a result. Reported when profiling.
+	size_t hits = 0;
+	size_t misses = 0;
+
+	// Get the result for these parameters, or null if there isn't one.
+	const Value *find(const Value &params) noexcept;
+
+	void insert(const Value &params, const Value &result) noexcept;
+
+	// Drop all results (`break cache`). The counters are kept.
+	void clear() noexcept;
+
+	size_t size() const noexcept { return entries.size(); }
+
+private:
+	struct Entry
+	{
+		size_t hash;
+		Value params;
+		Value result;
+	};
+
+	// Most recently used first.
+	std::list<Entry> entries;
+	std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+
+	std::list<Entry>::iterator lookup(size_t hash, const Value &params) noexcept;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+// Everything that programs compiled to native code (see STANDALONE.cpp.native) need.
+// Instructions without a direct C++ equivalent just call the same action that the interpreter would.
+
+#include "virtual_machine.hpp"
+
+#include "actions/call.hpp"
+#include "actions/copy.hpp"
+#include "actions/delete_cache.hpp"
+#include "actions/delete_var.hpp"
+#include "actions/destructure.hpp"
+#include "actions/get_cache_else_jump.hpp"
+#include "actions/get_exception_type.hpp"
+#include "actions/get.hpp"
+#include "actions/iter_begin.hpp"
+#include "actions/iter_next.hpp"
+#include "actions/pop_goto_index.hpp"
+#include "actions/pop_until_null.hpp"
+#include "actions/push_catch_loc.hpp"
+#include "actions/push_cmd_result.hpp"
+#include "actions/push_exception.hpp"
+#include "actions/push_index.hpp"
+#include "actions/run_command.hpp"
+#include "actions/set_cache.hpp"
+#include "actions/slice.hpp"
+#include "actions/swap.hpp"
+#include "actions/throw_exception.hpp"
+#include "actions/variable_insert.hpp"
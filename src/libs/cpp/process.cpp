@@ -0,0 +1,627 @@
+#include "process.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+// Start a program with the given file actions applied in the child.
+// This process ignores SIGPIPE while it writes to pipes, so children get the default handling back.
+static pid_t spawn(const std::vector<std::string> &argv, const posix_spawn_file_actions_t *actions) noexcept
+{
+	std::vector<char *> args;
+	args.reserve(argv.size() + 1);
+	for (const auto &arg : argv)
+	{
+		args.push_back(const_cast<char *>(arg.c_str()));
+	}
+	args.push_back(nullptr);
+
+	posix_spawnattr_t attributes;
+	posix_spawnattr_init(&attributes);
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGPIPE);
+	posix_spawnattr_setsigdefault(&attributes, &signals);
+	posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+
+	pid_t pid;
+	const int error = posix_spawnp(&pid, args[0], actions, &attributes, args.data(), environ);
+	posix_spawnattr_destroy(&attributes);
+
+	if (error)
+	{
+		errno = error;
+		return -1;
+	}
+	return pid;
+}
+
+pid_t spawn_process(const std::vector<std::string> &argv, int stdin_fd, int stdout_fd, int stderr_fd) noexcept
+{
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	const int fds[] = {stdin_fd, stdout_fd, stderr_fd};
+	for (int i = 0; i < 3; ++i)
+	{
+		if (fds[i] >= 0)
+		{
+			posix_spawn_file_actions_adddup2(&actions, fds[i], i);
+		}
+	}
+
+	const pid_t pid = spawn(argv, &actions);
+	posix_spawn_file_actions_destroy(&actions);
+	return pid;
+}
+
+int wait_process(pid_t pid) noexcept
+{
+	int status;
+	while (waitpid(pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+		{
+			return -1;
+		}
+	}
+
+	if (WIFSIGNALED(status))
+	{
+		return 128 + WTERMSIG(status);
+	}
+	return WEXITSTATUS(status);
+}
+
+Value ProcessResult::to_value() const noexcept
+{
+	return ObjectData{
+		{"status", status},
+		{"stdout", out},
+		{"stderr", err},
+	};
+}
+
+// Start a program with its stdout and stderr going to new pipes, and put the read ends in `fds`.
+// If it can't be started, -1 is returned, and the failure is put in `result` the way the shell would report it.
+static pid_t start(const std::vector<std::string> &argv, int fds[2], ProcessResult &result) noexcept
+{
+	int out_pipe[2] = {-1, -1};
+	int err_pipe[2] = {-1, -1};
+	pid_t pid = -1;
+	if (pipe2(out_pipe, O_CLOEXEC) == 0 && pipe2(err_pipe, O_CLOEXEC) == 0)
+	{
+		pid = spawn_process(argv, -1, out_pipe[1], err_pipe[1]);
+	}
+	const int error = errno;
+
+	for (int fd : {out_pipe[1], err_pipe[1]})
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+	}
+
+	if (pid < 0)
+	{
+		for (int fd : {out_pipe[0], err_pipe[0]})
+		{
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+		}
+
+		result.status = 127;
+		result.err = argv[0] + ": " + (error == ENOENT ? "command not found" : std::strerror(error)) + "\n";
+		return -1;
+	}
+
+	fds[0] = out_pipe[0];
+	fds[1] = err_pipe[0];
+	return pid;
+}
+
+// Read whatever is waiting in one of a program's output pipes.
+// Once the pipe is closed (usually because the program exited), the fd is closed and set to -1.
+static void drain(int &fd, std::string &target, std::ostream *echo) noexcept
+{
+	static char buffer[65536];
+	const ssize_t count = read(fd, buffer, sizeof(buffer));
+	if (count > 0)
+	{
+		target.append(buffer, count);
+		if (echo)
+		{
+			echo->write(buffer, count).flush();
+		}
+	}
+	else if (count == 0 || errno != EINTR)
+	{
+		close(fd);
+		fd = -1;
+	}
+}
+
+// Start one command of a pipeline, with its streams connected to the given fds unless it redirects them.
+// Redirect files are opened here rather than in the child, so that a file that can't be opened is reported
+// as such (the way the shell does), instead of as the program failing to start.
+// If the command can't be started, -1 is returned, and the failure is put in `result` the way the shell would report it.
+static pid_t spawn_stage(const PipelineStage &stage, int in_fd, int out_fd, int err_fd, ProcessResult &result) noexcept
+{
+	std::vector<int> files;
+	const auto open_file = [&](const std::string &file, int flags)
+	{
+		// Like the shell, give up on the command at the first file that can't be opened.
+		if (!result.err.empty())
+		{
+			return -1;
+		}
+
+		const int fd = open(file.c_str(), flags | O_CLOEXEC, 0666);
+		if (fd < 0)
+		{
+			result.status = 1;
+			result.err = file + ": " + std::strerror(errno) + "\n";
+		}
+		else
+		{
+			files.push_back(fd);
+		}
+		return fd;
+	};
+	const int write_flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+
+	if (!stage.in_file.empty())
+	{
+		in_fd = open_file(stage.in_file, O_RDONLY);
+	}
+	if (in_fd >= 0)
+	{
+		posix_spawn_file_actions_adddup2(&actions, in_fd, 0);
+	}
+
+	// Whichever stream is sent to the other one has to be set up second.
+	if (stage.out_to_err)
+	{
+		if (!stage.err_file.empty())
+		{
+			err_fd = open_file(stage.err_file, write_flags);
+		}
+		posix_spawn_file_actions_adddup2(&actions, err_fd, 2);
+		posix_spawn_file_actions_adddup2(&actions, 2, 1);
+	}
+	else
+	{
+		if (!stage.out_file.empty())
+		{
+			out_fd = open_file(stage.out_file, write_flags);
+		}
+		posix_spawn_file_actions_adddup2(&actions, out_fd, 1);
+
+		if (stage.err_to_out)
+		{
+			posix_spawn_file_actions_adddup2(&actions, 1, 2);
+		}
+		else
+		{
+			if (!stage.err_file.empty())
+			{
+				err_fd = open_file(stage.err_file, write_flags);
+			}
+			posix_spawn_file_actions_adddup2(&actions, err_fd, 2);
+		}
+	}
+
+	pid_t pid = -1;
+	if (result.err.empty())
+	{
+		pid = spawn(stage.argv, &actions);
+		const int error = errno;
+		if (pid < 0)
+		{
+			result.status = 127;
+			result.err = stage.argv[0] + ": " + (error == ENOENT ? "command not found" : std::strerror(error)) + "\n";
+		}
+	}
+	posix_spawn_file_actions_destroy(&actions);
+
+	// The child has its own copies of these now.
+	for (int fd : files)
+	{
+		close(fd);
+	}
+	return pid;
+}
+
+ProcessResult run_pipeline(const std::vector<PipelineStage> &stages, bool echo_out, bool echo_err) noexcept
+{
+	ProcessResult result;
+
+	// Anything the script already printed has to come out before the programs' output does.
+	std::cout.flush();
+	std::cerr.flush();
+
+	int out_pipe[2], err_pipe[2];
+	if (pipe2(out_pipe, O_CLOEXEC) < 0 || pipe2(err_pipe, O_CLOEXEC) < 0)
+	{
+		result.status = 127;
+		result.err = stages.front().argv[0] + ": " + std::strerror(errno) + "\n";
+		return result;
+	}
+
+	// Text to be written to a command's stdin, and how much of it has been written so far.
+	struct Input
+	{
+		int fd;
+		const std::string *text;
+		size_t offset;
+	};
+	std::vector<Input> inputs;
+
+	// A command that couldn't be started has no pid, just the status it failed with.
+	std::vector<pid_t> pids;
+	std::vector<int> failures;
+	int previous = -1;
+	for (size_t i = 0; i < stages.size(); ++i)
+	{
+		const auto &stage = stages[i];
+		const bool last = i + 1 == stages.size();
+
+		int in_fd = previous;
+		int link[2] = {-1, -1};
+		if (stage.has_input && pipe2(link, O_CLOEXEC) == 0)
+		{
+			fcntl(link[1], F_SETFL, O_NONBLOCK);
+			inputs.push_back({link[1], &stage.input, 0});
+			in_fd = link[0];
+		}
+
+		int next[2] = {-1, -1};
+		if (!last && pipe2(next, O_CLOEXEC) < 0)
+		{
+			next[0] = next[1] = -1;
+		}
+
+		ProcessResult failure;
+		const pid_t pid = spawn_stage(stage, in_fd, last ? out_pipe[1] : next[1], err_pipe[1], failure);
+		pids.push_back(pid);
+		failures.push_back(failure.status);
+
+		if (pid < 0)
+		{
+			result.err += failure.err;
+			if (echo_err)
+			{
+				std::cerr << failure.err << std::flush;
+			}
+		}
+
+		// The child has its own copies of these now.
+		for (int fd : {previous, link[0], next[1]})
+		{
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+		}
+		previous = next[0];
+	}
+	if (previous >= 0)
+	{
+		close(previous);
+	}
+	close(out_pipe[1]);
+	close(err_pipe[1]);
+
+	// A command that exits without reading all of its input must not take this process down with it.
+	// The previous handling is put back afterwards, so the script still stops when its own stdout is closed.
+	struct sigaction ignore = {}, previous_pipe_action;
+	ignore.sa_handler = SIG_IGN;
+	sigemptyset(&ignore.sa_mask);
+	if (!inputs.empty())
+	{
+		sigaction(SIGPIPE, &ignore, &previous_pipe_action);
+	}
+
+	int outputs[] = {out_pipe[0], err_pipe[0]};
+	std::string *const targets[] = {&result.out, &result.err};
+	std::ostream *const echoes[] = {echo_out ? &std::cout : nullptr, echo_err ? &std::cerr : nullptr};
+	std::vector<pollfd> polls;
+	while (outputs[0] >= 0 || outputs[1] >= 0)
+	{
+		polls.clear();
+		for (int fd : outputs)
+		{
+			polls.push_back({fd, POLLIN, 0});
+		}
+		for (const auto &input : inputs)
+		{
+			polls.push_back({input.fd, POLLOUT, 0});
+		}
+
+		if (poll(polls.data(), polls.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		for (int i = 0; i < 2; ++i)
+		{
+			if (polls[i].revents)
+			{
+				drain(outputs[i], *targets[i], echoes[i]);
+			}
+		}
+
+		for (size_t i = 0; i < inputs.size(); ++i)
+		{
+			auto &input = inputs[i];
+			if (input.fd < 0 || !polls[i + 2].revents)
+			{
+				continue;
+			}
+
+			const ssize_t count = write(input.fd, input.text->data() + input.offset, input.text->size() - input.offset);
+			if (count > 0)
+			{
+				input.offset += count;
+			}
+
+			// Once all of the text is written (or the command has stopped reading), it gets end-of-file.
+			if (input.offset == input.text->size() || (count < 0 && errno != EAGAIN && errno != EINTR))
+			{
+				close(input.fd);
+				input.fd = -1;
+			}
+		}
+	}
+
+	for (int fd : outputs)
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+	}
+	for (const auto &input : inputs)
+	{
+		if (input.fd >= 0)
+		{
+			close(input.fd);
+		}
+	}
+	if (!inputs.empty())
+	{
+		sigaction(SIGPIPE, &previous_pipe_action, nullptr);
+	}
+
+	for (size_t i = 0; i < pids.size(); ++i)
+	{
+		result.status = pids[i] < 0 ? failures[i] : wait_process(pids[i]);
+	}
+	return result;
+}
+
+size_t ProcessPool::spawn(const std::vector<std::string> &argv, size_t max_running) noexcept
+{
+	while (running > 0 && running >= max_running)
+	{
+		update();
+	}
+
+	Job job{};
+	job.pid = start(argv, job.fds, job.result);
+	job.done = job.pid < 0;
+	if (!job.done)
+	{
+		++running;
+	}
+
+	jobs.emplace(next_handle, std::move(job));
+	return next_handle++;
+}
+
+bool ProcessPool::await(size_t handle, ProcessResult &result) noexcept
+{
+	auto job = jobs.find(handle);
+	if (job == jobs.end())
+	{
+		return false;
+	}
+
+	while (!job->second.done)
+	{
+		update();
+	}
+
+	result = std::move(job->second.result);
+	jobs.erase(job);
+	return true;
+}
+
+size_t ProcessPool::await_any(const std::vector<size_t> &handles) noexcept
+{
+	while (true)
+	{
+		bool valid = false;
+		for (size_t handle : handles)
+		{
+			auto job = jobs.find(handle);
+			if (job != jobs.end())
+			{
+				if (job->second.done)
+				{
+					return handle;
+				}
+				valid = true;
+			}
+		}
+
+		if (!valid)
+		{
+			return 0;
+		}
+		update();
+	}
+}
+
+void ProcessPool::update() noexcept
+{
+	std::vector<pollfd> polls;
+	std::vector<std::pair<Job *, int>> streams;
+	for (auto &entry : jobs)
+	{
+		auto &job = entry.second;
+		for (int i = 0; i < 2; ++i)
+		{
+			if (!job.done && job.fds[i] >= 0)
+			{
+				polls.push_back({job.fds[i], POLLIN, 0});
+				streams.push_back({&job, i});
+			}
+		}
+	}
+
+	if (polls.empty() || poll(polls.data(), polls.size(), -1) < 0)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < polls.size(); ++i)
+	{
+		if (!polls[i].revents)
+		{
+			continue;
+		}
+
+		auto &job = *streams[i].first;
+		const int stream = streams[i].second;
+		drain(job.fds[stream], stream ? job.result.err : job.result.out, nullptr);
+
+		if (job.fds[0] < 0 && job.fds[1] < 0)
+		{
+			job.result.status = wait_process(job.pid);
+			job.done = true;
+			--running;
+		}
+	}
+}
+
+ProcessPool &process_pool() noexcept
+{
+	static ProcessPool pool;
+	return pool;
+}
+
+LineStream::LineStream(const std::vector<std::string> &argv) noexcept
+{
+	std::cout.flush();
+
+	int pipe_fds[2];
+	if (pipe2(pipe_fds, O_CLOEXEC) < 0)
+	{
+		std::cerr << argv[0] << ": " << std::strerror(errno) << std::endl;
+		return;
+	}
+
+	pid = spawn_process(argv, -1, pipe_fds[1], -1);
+	const int error = errno;
+	close(pipe_fds[1]);
+
+	if (pid < 0)
+	{
+		close(pipe_fds[0]);
+		std::cerr << argv[0] << ": " << (error == ENOENT ? "command not found" : std::strerror(error)) << std::endl;
+		return;
+	}
+	fd = pipe_fds[0];
+}
+
+LineStream::~LineStream()
+{
+	if (fd >= 0 && pid >= 0)
+	{
+		kill(pid, SIGTERM);
+	}
+	finish();
+}
+
+bool LineStream::next(std::string &line) noexcept
+{
+	while (true)
+	{
+		const size_t end = buffer.find('\n', offset);
+		if (end != std::string::npos)
+		{
+			line.assign(buffer, offset, end - offset);
+			offset = end + 1;
+			return true;
+		}
+
+		// Drop the lines that have been read, so the buffer only ever holds about one read's worth.
+		buffer.erase(0, offset);
+		offset = 0;
+
+		const size_t size = buffer.size();
+		buffer.resize(size + 65536);
+		const ssize_t count = fd >= 0 ? read(fd, &buffer[size], 65536) : 0;
+		buffer.resize(size + (count > 0 ? count : 0));
+
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (count <= 0)
+		{
+			finish();
+
+			// The last line may not have a line ending.
+			if (buffer.empty())
+			{
+				return false;
+			}
+			line = std::move(buffer);
+			buffer.clear();
+			return true;
+		}
+	}
+}
+
+void LineStream::finish() noexcept
+{
+	if (fd >= 0)
+	{
+		close(fd);
+		fd = -1;
+	}
+	if (pid >= 0)
+	{
+		wait_process(pid);
+		pid = -1;
+	}
+}
+
+std::vector<std::string> command_argv(const Value &command) noexcept
+{
+	if (std::holds_alternative<String>(command))
+	{
+		return {"/bin/sh", "-c", command.to_string()};
+	}
+	return command.to_string_array();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "value.hpp"
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+// The output of a finished command.
+struct ProcessResult
+{
+	// The exit code, or 128 + the signal number if the process was killed (as the shell reports it).
+	int status = 0;
+	std::string out;
+	std::string err;
+
+	// The result as the script sees it: an object with "status", "stdout" and "stderr" keys.
+	Value to_value() const noexcept;
+};
+
+// Start a program with the given arguments, without going through the shell.
+// The program is looked up in PATH. Each of `stdin_fd`, `stdout_fd` and `stderr_fd`
+// replaces that stream in the child, or is inherited from this process if it's -1.
+// Returns the child's pid, or -1 (with errno set) if it couldn't be started.
+pid_t spawn_process(const std::vector<std::string> &argv, int stdin_fd, int stdout_fd, int stderr_fd) noexcept;
+
+// Wait for a child process to exit, and get its exit status (see ProcessResult::status).
+int wait_process(pid_t pid) noexcept;
+
+// One command in a pipeline (`a | b | c`), and where its streams are redirected.
+struct PipelineStage
+{
+	std::vector<std::string> argv;
+
+	// Files to read stdin from (`<`), and write stdout and stderr to (`?>`, `!>`). Empty if not redirected.
+	std::string in_file;
+	std::string out_file;
+	std::string err_file;
+
+	// Send stdout to wherever stderr goes (`?>!`), or the other way around (`!>?`).
+	bool out_to_err = false;
+	bool err_to_out = false;
+
+	// Text to write to stdin (`<<<`), instead of it coming from the previous command.
+	bool has_input = false;
+	std::string input;
+};
+
+// Run a pipeline to completion, capturing the stdout of the last command and the stderr of all of them.
+// Each command's stdout is connected straight to the next one's stdin, so the data between them never
+// passes through this process. Input text and the captured output are written and read as the pipes
+// are ready, so a chatty program never blocks on a full pipe.
+// If `echo_out` or `echo_err` is set, that stream is also passed through to this process's own stream.
+// The status is that of the last command. A command that can't be started reports an error in `err`
+// and gets status 127, like the shell does. A redirect file that can't be opened is reported as
+// `<file>: <reason>`, and that command isn't started and gets status 1.
+ProcessResult run_pipeline(const std::vector<PipelineStage> &stages, bool echo_out, bool echo_err) noexcept;
+
+// Commands running in the background (`cmd_spawn()` and friends), identified by a handle number.
+// Whenever the script waits on any of them, the output of every running command is read in the
+// same poll() loop, so no command stalls on a full pipe while another one is being waited for.
+class ProcessPool
+{
+public:
+	// Start a command. If `max_running` commands are already running, wait for one of them to finish first.
+	// A command that can't be started still gets a handle, and finishes straight away with status 127.
+	size_t spawn(const std::vector<std::string> &argv, size_t max_running) noexcept;
+
+	// Wait for a command to finish, and take its result. Each result can only be taken once.
+	// Returns false if there's no command with that handle.
+	bool await(size_t handle, ProcessResult &result) noexcept;
+
+	// Wait until any one of these commands has finished, and return its handle.
+	// Its result is left for await(). Returns 0 if none of the handles are valid.
+	size_t await_any(const std::vector<size_t> &handles) noexcept;
+
+private:
+	struct Job
+	{
+		pid_t pid;
+
+		// Read ends of the stdout and stderr pipes, or -1 once they're closed.
+		int fds[2];
+
+		ProcessResult result;
+		bool done;
+	};
+
+	std::unordered_map<size_t, Job> jobs;
+	size_t next_handle = 1;
+	size_t running = 0;
+
+	// Wait until there is output from any running command, read it, and collect any commands that have finished.
+	void update() noexcept;
+};
+
+ProcessPool &process_pool() noexcept;
+
+// The output of a running command, read one line at a time (see ArrayData::stream).
+// Output is only read as lines are asked for, so a command that writes faster than the script
+// uses its output is held up by the pipe filling, instead of the output piling up in memory.
+// The command's stderr is passed straight through.
+class LineStream
+{
+public:
+	explicit LineStream(const std::vector<std::string> &argv) noexcept;
+
+	// If the output wasn't read to the end, the command is stopped.
+	~LineStream();
+
+	LineStream(const LineStream &) = delete;
+	LineStream &operator=(const LineStream &) = delete;
+
+	// Read the next line, without its line ending. Returns false once the output has all been read.
+	bool next(std::string &line) noexcept;
+
+private:
+	pid_t pid = -1;
+	int fd = -1;
+	std::string buffer;
+	size_t offset = 0;
+
+	void finish() noexcept;
+};
+
+// Get the program and arguments to run for a command given to a function:
+// an array is the program followed by its arguments, and a string is run by the shell.
+std::vector<std::string> command_argv(const Value &command) noexcept;
@@ -0,0 +1,120 @@
+#include "profile.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Opcode names, indexed by opcode - 1.
+static const char *const OPCODE_NAMES[] = {
+	"call",
+	"set",
+	"get",
+	"push",
+	"pop",
+	"run_command",
+	"push_cmd_result",
+	"push_index",
+	"pop_goto_index",
+	"copy",
+	"delete_var",
+	"swap",
+	"pop_until_null",
+	"get_cache_else_jump",
+	"set_cache",
+	"delete_cache",
+	"push_catch_loc",
+	"variable_insert",
+	"destructure",
+	"get_exception_type",
+	"push_exception",
+	"throw_exception",
+	"jump",
+	"jumpiffalse",
+	"jumpifnil",
+	"call_args",
+	"get_get",
+	"get_push",
+	"push_get",
+	"push_push",
+	"set_get",
+	"call_set",
+	"pop_jump_if_false",
+	"jump_if_nil_set",
+	"iter_begin",
+	"iter_next",
+	"iter_next_set",
+	"slice",
+};
+
+static const size_t REPORT_LINES = 40;
+
+class Profile
+{
+	std::string previous[2];
+	std::map<std::string, size_t> counts;
+
+public:
+	void step(const Instruction &instruction) noexcept
+	{
+		const size_t opcode = instruction.opcode - 1;
+		std::string name = (opcode < sizeof(OPCODE_NAMES) / sizeof(OPCODE_NAMES[0])) ? OPCODE_NAMES[opcode] : "?";
+
+		// Calls are only interesting together with the function being called.
+		if (instruction.opcode == OP_CALL || instruction.opcode == OP_CALL_ARGS || instruction.opcode == OP_CALL_SET)
+		{
+			name += " " + std::to_string(instruction.operand0);
+		}
+
+		if (!previous[1].empty())
+		{
+			counts[previous[1] + "; " + name]++;
+			if (!previous[0].empty())
+			{
+				counts[previous[0] + "; " + previous[1] + "; " + name]++;
+			}
+		}
+
+		previous[0] = std::move(previous[1]);
+		previous[1] = std::move(name);
+	}
+
+	~Profile()
+	{
+		std::vector<std::pair<size_t, std::string>> sorted;
+		for (const auto &i : counts)
+		{
+			sorted.emplace_back(i.second, i.first);
+		}
+		std::sort(sorted.rbegin(), sorted.rend());
+
+		std::cerr << "Most frequent instruction sequences:" << std::endl;
+		for (size_t i = 0; i < sorted.size() && i < REPORT_LINES; i++)
+		{
+			std::cerr << sorted[i].first << "\t" << sorted[i].second << std::endl;
+		}
+	}
+};
+
+void profile(const VirtualMachine &vm) noexcept
+{
+	// Only created once profiling starts, and destroyed (so reported) on exit,
+	// even if the program ends with an error.
+	static Profile instance;
+	instance.step(vm.instructions[vm.instruction_index]);
+}
+
+void profile_caches(const VirtualMachine &vm) noexcept
+{
+	if (vm.cache.empty())
+	{
+		return;
+	}
+
+	std::cerr << "Subroutine caches (id, hits, misses, size):" << std::endl;
+	for (const auto &[id, cache] : vm.cache)
+	{
+		std::cerr << id << "\t" << cache.hits << "\t" << cache.misses << "\t" << cache.size() << std::endl;
+	}
+}
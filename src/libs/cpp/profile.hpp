@@ -0,0 +1,12 @@
+#pragma once
+
+#include "virtual_machine.hpp"
+
+// Instruction sequence profiling, for deciding which sequences are worth fusing into
+// superinstructions (see STANDALONE.cpp.fuse in cpp.lua).
+// Only used if the runtime is built with -DPAISLEY_PROFILE. The most frequently executed
+// sequences of 2 and 3 instructions are printed to stderr when the program exits.
+void profile(const VirtualMachine &vm) noexcept;
+
+// Print how often each memoized subroutine's cache was hit or missed.
+void profile_caches(const VirtualMachine &vm) noexcept;
@@ -0,0 +1,534 @@
+#include "shell_utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+// A utility gets its arguments (without the program name) and its stdin, which is null if it doesn't have any.
+// It fills in the result, or returns false to have the real program run instead.
+using ShellUtil = bool (*)(const std::vector<std::string> &args, const std::string *input, ProcessResult &result);
+
+// Files bigger than this are left to the real programs, which stream them instead of holding them in memory.
+static constexpr off_t MAX_FILE_SIZE = 16 << 20;
+
+// Open a file to read, if it's a regular file. Anything else (a directory, a device like /dev/zero, a FIFO)
+// is left to the real programs: it may never end, and each stage here reads all of its input before the next one starts.
+static int open_regular_file(const std::string &path, struct stat &info) noexcept
+{
+	const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return -1;
+	}
+
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+// Read a whole regular file, appending it to `data`.
+static bool read_file(const std::string &path, std::string &data) noexcept
+{
+	struct stat info;
+	const int fd = open_regular_file(path, info);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	if (info.st_size > MAX_FILE_SIZE)
+	{
+		close(fd);
+		return false;
+	}
+
+	char buffer[65536];
+	ssize_t count;
+	while ((count = read(fd, buffer, sizeof(buffer))) > 0)
+	{
+		data.append(buffer, count);
+	}
+	close(fd);
+	return count == 0;
+}
+
+// The length of the first `count` lines of some text (or all of it, if it has fewer).
+// `count` is reduced by the number of lines found.
+static size_t first_lines(std::string_view text, size_t &count) noexcept
+{
+	size_t end = 0;
+	while (count > 0 && end < text.size())
+	{
+		const auto next = text.find('\n', end);
+		if (next == std::string_view::npos)
+		{
+			return text.size();
+		}
+		end = next + 1;
+		--count;
+	}
+	return end;
+}
+
+// Read the first `count` lines of a regular file, appending them to `data`.
+// Only as much of the file is read as it takes to find them, however big it is.
+static bool read_file_lines(const std::string &path, size_t count, std::string &data) noexcept
+{
+	struct stat info;
+	const int fd = open_regular_file(path, info);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	char buffer[65536];
+	ssize_t size = 0;
+	while (count > 0 && (size = read(fd, buffer, sizeof(buffer))) > 0)
+	{
+		data.append(buffer, first_lines(std::string_view(buffer, size), count));
+	}
+	close(fd);
+	return size >= 0;
+}
+
+// Get the text a utility works on: its file operands one after another, or stdin if there are none.
+// `-` (stdin as an operand) is left to the real programs.
+static bool read_input(const std::vector<std::string> &files, const std::string *input, std::string &data) noexcept
+{
+	if (files.empty())
+	{
+		if (!input)
+		{
+			return false;
+		}
+		data += *input;
+		return true;
+	}
+
+	for (const auto &file : files)
+	{
+		if (file == "-" || !read_file(file, data))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Split text into lines, without their line breaks. A last line with no line break still counts.
+static std::vector<std::string_view> split_lines(const std::string &text) noexcept
+{
+	std::vector<std::string_view> lines;
+	size_t start = 0;
+	while (start < text.size())
+	{
+		auto end = text.find('\n', start);
+		if (end == std::string::npos)
+		{
+			end = text.size();
+		}
+		lines.emplace_back(text.data() + start, end - start);
+		start = end + 1;
+	}
+	return lines;
+}
+
+// Split arguments into single-letter options and operands.
+// Options have to come first: GNU's handling of options after operands (and of `--`) is left to the real programs.
+// Returns false if there's an option that isn't in `allowed`.
+static bool parse_options(const std::vector<std::string> &args, std::string_view allowed, std::string &options, std::vector<std::string> &operands) noexcept
+{
+	size_t i = 0;
+	for (; i < args.size() && args[i].size() > 1 && args[i][0] == '-'; ++i)
+	{
+		for (size_t k = 1; k < args[i].size(); ++k)
+		{
+			if (allowed.find(args[i][k]) == std::string_view::npos)
+			{
+				return false;
+			}
+			options += args[i][k];
+		}
+	}
+
+	for (; i < args.size(); ++i)
+	{
+		if (args[i].size() > 1 && args[i][0] == '-')
+		{
+			return false;
+		}
+		operands.push_back(args[i]);
+	}
+	return true;
+}
+
+// Whether the locale compares text byte by byte, like the C locale does.
+// Otherwise sorting follows the locale's collation rules, which are left to the real programs.
+static bool bytewise_collation() noexcept
+{
+	for (const char *name : {"LC_ALL", "LC_COLLATE", "LANG"})
+	{
+		const char *value = getenv(name);
+		if (value && *value)
+		{
+			const std::string_view locale = value;
+			return locale == "C" || locale == "POSIX" || locale.substr(0, 2) == "C.";
+		}
+	}
+	return true;
+}
+
+// Whether a file name is printed as it is. Names with control characters get quoted.
+static bool printable_name(const std::string &name) noexcept
+{
+	return std::none_of(name.begin(), name.end(), [](char c)
+						{ return (c >= 0 && c < ' ') || c == 0x7f; });
+}
+
+// A count, the way printf's %d would write it.
+static std::string count_text(size_t count, int width = 0) noexcept
+{
+	char text[32];
+	snprintf(text, sizeof(text), "%*zu", width, count);
+	return text;
+}
+
+static bool util_basename(const std::vector<std::string> &args, const std::string *, ProcessResult &result)
+{
+	if (args.empty() || args.size() > 2 || std::any_of(args.begin(), args.end(), [](const std::string &arg)
+														 { return arg.size() > 1 && arg[0] == '-'; }))
+	{
+		return false;
+	}
+
+	// A name that's nothing but slashes is the root directory.
+	auto name = args[0];
+	const auto last = name.find_last_not_of('/');
+	if (last == std::string::npos)
+	{
+		result.out = name.empty() ? "\n" : "/\n";
+		return true;
+	}
+	name.erase(last + 1);
+	name.erase(0, name.rfind('/') + 1);
+
+	// The suffix is only removed if there's something left.
+	if (args.size() == 2)
+	{
+		const auto &suffix = args[1];
+		if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+		{
+			name.erase(name.size() - suffix.size());
+		}
+	}
+
+	result.out = name + "\n";
+	return true;
+}
+
+static bool util_cat(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	std::string options;
+	std::vector<std::string> files;
+	return parse_options(args, "", options, files) && read_input(files, input, result.out);
+}
+
+static bool util_grep(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	// Only counting the lines that contain a plain string, in at most one file (more files get name prefixes).
+	std::string options;
+	std::vector<std::string> operands;
+	if (!parse_options(args, "c", options, operands) || options.empty() || operands.empty() || operands.size() > 2)
+	{
+		return false;
+	}
+
+	// The pattern can't have anything that's special in a regular expression.
+	const auto &pattern = operands[0];
+	for (const char c : pattern)
+	{
+		if (c < ' ' || c > '~' || std::string_view(".[]*^$\\").find(c) != std::string_view::npos)
+		{
+			return false;
+		}
+	}
+
+	// Null bytes make grep treat the text as binary, which changes where lines end.
+	std::string text;
+	const std::vector<std::string> files(operands.begin() + 1, operands.end());
+	if (!read_input(files, input, text) || text.find('\0') != std::string::npos)
+	{
+		return false;
+	}
+
+	size_t count = 0;
+	for (const auto line : split_lines(text))
+	{
+		if (line.find(pattern) != std::string_view::npos)
+		{
+			++count;
+		}
+	}
+
+	result.out = count_text(count) + "\n";
+	result.status = count > 0 ? 0 : 1;
+	return true;
+}
+
+static bool util_head(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	// Only a number of lines: `-n N`, `-nN`, or `-N` as the first argument. More than one file gets headers.
+	size_t count = 10;
+	std::vector<std::string> files;
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		const auto &arg = args[i];
+		if (arg.size() < 2 || arg[0] != '-')
+		{
+			files.push_back(arg);
+			continue;
+		}
+
+		std::string number;
+		if (arg == "-n" && i + 1 < args.size())
+		{
+			number = args[++i];
+		}
+		else if (arg.compare(0, 2, "-n") == 0)
+		{
+			number = arg.substr(2);
+		}
+		else if (i == 0)
+		{
+			number = arg.substr(1);
+		}
+
+		if (!files.empty() || number.empty() || number.size() > 18 || number.find_first_not_of("0123456789") != std::string::npos)
+		{
+			return false;
+		}
+		count = std::stoull(number);
+	}
+
+	if (files.size() > 1 || (files.empty() && !input) || (!files.empty() && files[0] == "-"))
+	{
+		return false;
+	}
+
+	if (!files.empty())
+	{
+		return read_file_lines(files[0], count, result.out);
+	}
+
+	result.out.assign(*input, 0, first_lines(*input, count));
+	return true;
+}
+
+static bool util_ls(const std::vector<std::string> &args, const std::string *, ProcessResult &result)
+{
+	// Output that isn't a terminal is one name per line, with names as they are (unless QUOTING_STYLE says otherwise).
+	// More than one operand gets headers.
+	std::string options;
+	std::vector<std::string> paths;
+	if (!parse_options(args, "1aA", options, paths) || paths.size() > 1 || getenv("QUOTING_STYLE") || !bytewise_collation())
+	{
+		return false;
+	}
+
+	const auto path = paths.empty() ? std::string(".") : paths[0];
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+	{
+		return false;
+	}
+
+	if (!S_ISDIR(info.st_mode))
+	{
+		result.out = path + "\n";
+		return true;
+	}
+
+	DIR *dir = opendir(path.c_str());
+	if (!dir)
+	{
+		return false;
+	}
+
+	// Whichever of -a and -A comes last wins.
+	const auto hidden = options.find_last_of("aA");
+	const bool all = hidden != std::string::npos && options[hidden] == 'a';
+	const bool almost_all = hidden != std::string::npos && options[hidden] == 'A';
+
+	std::vector<std::string> names;
+	while (const dirent *entry = readdir(dir))
+	{
+		const std::string name = entry->d_name;
+		if (name[0] == '.' && !all && !(almost_all && name != "." && name != ".."))
+		{
+			continue;
+		}
+		names.push_back(name);
+	}
+	closedir(dir);
+
+	std::sort(names.begin(), names.end());
+	for (const auto &name : names)
+	{
+		result.out += name;
+		result.out += '\n';
+	}
+	return true;
+}
+
+static bool util_sort(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	// Only plain, reversed or unique sorting of at most one file, so that no lines get joined across files.
+	std::string options;
+	std::vector<std::string> files;
+	std::string text;
+	if (!parse_options(args, "ru", options, files) || files.size() > 1 || !bytewise_collation() || !read_input(files, input, text))
+	{
+		return false;
+	}
+
+	auto lines = split_lines(text);
+	std::sort(lines.begin(), lines.end());
+	if (options.find('r') != std::string::npos)
+	{
+		std::reverse(lines.begin(), lines.end());
+	}
+	if (options.find('u') != std::string::npos)
+	{
+		lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+	}
+
+	for (const auto line : lines)
+	{
+		result.out += line;
+		result.out += '\n';
+	}
+	return true;
+}
+
+static bool util_uniq(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	// A second operand is a file to write to.
+	std::string options;
+	std::vector<std::string> files;
+	std::string text;
+	if (!parse_options(args, "c", options, files) || files.size() > 1 || !read_input(files, input, text))
+	{
+		return false;
+	}
+
+	const bool counts = !options.empty();
+	const auto lines = split_lines(text);
+	for (size_t i = 0; i < lines.size();)
+	{
+		size_t next = i + 1;
+		while (next < lines.size() && lines[next] == lines[i])
+		{
+			++next;
+		}
+
+		if (counts)
+		{
+			result.out += count_text(next - i, 7) + " ";
+		}
+		result.out += lines[i];
+		result.out += '\n';
+		i = next;
+	}
+	return true;
+}
+
+static bool util_wc(const std::vector<std::string> &args, const std::string *input, ProcessResult &result)
+{
+	// Only line counts, of at most one file: with more, the column widths depend on the file sizes.
+	std::string options;
+	std::vector<std::string> files;
+	std::string text;
+	if (!parse_options(args, "l", options, files) || options.empty() || files.size() > 1 ||
+		(!files.empty() && !printable_name(files[0])) || !read_input(files, input, text))
+	{
+		return false;
+	}
+
+	result.out = count_text(std::count(text.begin(), text.end(), '\n'));
+	if (!files.empty())
+	{
+		result.out += " " + files[0];
+	}
+	result.out += "\n";
+	return true;
+}
+
+static const std::unordered_map<std::string, ShellUtil> SHELL_UTILS = {
+	{"basename", util_basename},
+	{"cat", util_cat},
+	{"grep", util_grep},
+	{"head", util_head},
+	{"ls", util_ls},
+	{"sort", util_sort},
+	{"uniq", util_uniq},
+	{"wc", util_wc},
+};
+
+bool run_shell_utils(const std::vector<PipelineStage> &stages, ProcessResult &result) noexcept
+{
+	// Check every command first, so nothing gets read if the pipeline has to be run for real anyway.
+	std::vector<ShellUtil> utils;
+	for (const auto &stage : stages)
+	{
+		const auto util = SHELL_UTILS.find(stage.argv[0]);
+		if (util == SHELL_UTILS.end() || !stage.out_file.empty() || !stage.err_file.empty() ||
+			stage.out_to_err || stage.err_to_out || (stage.has_input && !stage.in_file.empty()))
+		{
+			return false;
+		}
+		utils.push_back(util->second);
+	}
+
+	// Each command's stdin is the previous one's stdout, unless it's redirected.
+	// Only regular files are read (see open_regular_file()), so every command's input has an end.
+	ProcessResult output;
+	for (size_t i = 0; i < stages.size(); ++i)
+	{
+		const auto &stage = stages[i];
+		const std::string previous = std::move(output.out);
+		const std::string *input = i > 0 ? &previous : nullptr;
+
+		std::string file;
+		if (!stage.in_file.empty())
+		{
+			if (!read_file(stage.in_file, file))
+			{
+				return false;
+			}
+			input = &file;
+		}
+		else if (stage.has_input)
+		{
+			input = &stage.input;
+		}
+
+		output = ProcessResult();
+		const std::vector<std::string> args(stage.argv.begin() + 1, stage.argv.end());
+		if (!utils[i](args, input, output))
+		{
+			return false;
+		}
+	}
+
+	result = std::move(output);
+	return true;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "process.hpp"
+
+// Common shell utilities, run inside this process instead of starting a program for each one:
+// `cat`, `ls`, `wc -l`, `head`, `grep -c`, `sort`, `uniq` and `basename`.
+// Only the options and cases whose output is certain to match GNU coreutils and grep are handled.
+// Returns false if any command in the pipeline isn't one of them, uses anything else (an option, a redirect
+// to a file, a file that can't be read...), or needs the terminal's stdin. The pipeline should then be run
+// for real, so that anything unusual gets exactly the real programs' output and error messages.
+// Each command runs to completion before the next one starts, so files are only read if they're regular files
+// of a limited size: devices, FIFOs and huge files go to the real programs, which stream them.
+// `head` only reads as many lines of its file as it prints.
+bool run_shell_utils(const std::vector<PipelineStage> &stages, ProcessResult &result) noexcept;
@@ -14,11 +14,6 @@ Value Stack::pop() noexcept
 	return value;
 }
 
-void Stack::push(const Value &value) noexcept
-{
-	push_back(value);
-}
-
 void Stack::print() const noexcept
 {
 	std::cout << "STACK DUMP:" << std::endl;
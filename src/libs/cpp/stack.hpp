@@ -7,7 +7,10 @@ public:
 	Stack(std::initializer_list<Value> values) noexcept : std::vector<Value>(values) {}
 
 	Value pop() noexcept;
-	void push(const Value &value) noexcept;
+	void push(const Value &value) noexcept
+	{
+		push_back(value);
+	}
 
 	void print() const noexcept;
 };
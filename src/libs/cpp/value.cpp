@@ -1,26 +1,24 @@
 #include "value.hpp"
+#include "process.hpp"
 #include <sstream>
-
-bool Value::is_null() const noexcept
-{
-	const auto i = index();
-	return i > 100 || i == 0; // Hack to correctly check for null variant
-}
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
 bool Value::to_bool() const noexcept
 {
 	// Empty strings, empty arrays, empty objects, and null are false
-	if (std::holds_alternative<std::string>(*this))
+	if (std::holds_alternative<String>(*this))
 	{
-		return !std::get<std::string>(*this).empty();
+		return !std::get<String>(*this).empty();
 	}
-	else if (std::holds_alternative<std::vector<Value>>(*this))
+	else if (std::holds_alternative<Array>(*this))
 	{
-		return !std::get<std::vector<Value>>(*this).empty();
+		return !std::get<Array>(*this).empty();
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(*this))
+	else if (std::holds_alternative<Object>(*this))
 	{
-		return !std::get<std::map<std::string, Value>>(*this).empty();
+		return !std::get<Object>(*this).empty();
 	}
 	// Numbers are false if they are 0
 	else if (std::holds_alternative<double>(*this))
@@ -42,11 +40,11 @@ double Value::to_number() const noexcept
 	{
 		return std::get<double>(*this);
 	}
-	else if (std::holds_alternative<std::string>(*this))
+	else if (std::holds_alternative<String>(*this))
 	{
 		try
 		{
-			return std::stod(std::get<std::string>(*this));
+			return std::stod(std::get<String>(*this));
 		}
 		catch (const std::invalid_argument &)
 		{
@@ -64,9 +62,9 @@ double Value::to_number() const noexcept
 
 std::string Value::to_string() const noexcept
 {
-	if (std::holds_alternative<std::string>(*this))
+	if (std::holds_alternative<String>(*this))
 	{
-		return std::get<std::string>(*this);
+		return std::get<String>(*this);
 	}
 	else if (std::holds_alternative<double>(*this))
 	{
@@ -88,11 +86,11 @@ std::string Value::to_string() const noexcept
 		return std::get<bool>(*this) ? "1" : "0";
 	}
 	// Arrays get converted to a space-delimited string
-	else if (std::holds_alternative<std::vector<Value>>(*this))
+	else if (std::holds_alternative<Array>(*this))
 	{
 		std::string result;
 		bool first = true;
-		for (const Value &value : std::get<std::vector<Value>>(*this))
+		for (const Value &value : std::get<Array>(*this))
 		{
 			if (!first)
 			{
@@ -104,11 +102,11 @@ std::string Value::to_string() const noexcept
 		return result;
 	}
 	// Objects get converted to a space-delimited key-value pair string
-	else if (std::holds_alternative<std::map<std::string, Value>>(*this))
+	else if (std::holds_alternative<Object>(*this))
 	{
 		std::string result;
 		bool first = true;
-		for (const auto &pair : std::get<std::map<std::string, Value>>(*this))
+		for (const auto &pair : std::get<Object>(*this))
 		{
 			if (!first)
 			{
@@ -127,18 +125,18 @@ std::string Value::to_string() const noexcept
 std::vector<Value> Value::to_array() const noexcept
 {
 	std::vector<Value> result;
-	if (std::holds_alternative<std::map<std::string, Value>>(*this))
+	if (std::holds_alternative<Object>(*this))
 	{
-		for (const auto &pair : std::get<std::map<std::string, Value>>(*this))
+		for (const auto &pair : std::get<Object>(*this))
 		{
 			result.push_back(pair.first);
 			result.push_back(pair.second);
 		}
 		return result;
 	}
-	else if (std::holds_alternative<std::vector<Value>>(*this))
+	else if (std::holds_alternative<Array>(*this))
 	{
-		return std::get<std::vector<Value>>(*this);
+		return std::get<Array>(*this);
 	}
 
 	result.push_back(*this);
@@ -146,11 +144,11 @@ std::vector<Value> Value::to_array() const noexcept
 	return result;
 }
 
-std::map<std::string, Value> Value::to_object() const noexcept
+ObjectData Value::to_object() const noexcept
 {
-	if (std::holds_alternative<std::map<std::string, Value>>(*this))
+	if (std::holds_alternative<Object>(*this))
 	{
-		return std::get<std::map<std::string, Value>>(*this);
+		return std::get<Object>(*this);
 	}
 
 	return {};
@@ -161,9 +159,9 @@ std::vector<std::string> Value::to_string_array() const noexcept
 	std::vector<std::string> result;
 	for (const Value &value : to_array())
 	{
-		if (std::holds_alternative<std::vector<Value>>(value))
+		if (std::holds_alternative<Array>(value))
 		{
-			for (const auto &sub_value : std::get<std::vector<Value>>(value))
+			for (const auto &sub_value : std::get<Array>(value))
 			{
 				for (const auto &sub_sub_value : sub_value.to_string_array())
 				{
@@ -171,9 +169,9 @@ std::vector<std::string> Value::to_string_array() const noexcept
 				}
 			}
 		}
-		else if (std::holds_alternative<std::map<std::string, Value>>(value))
+		else if (std::holds_alternative<Object>(value))
 		{
-			for (const auto &pair : std::get<std::map<std::string, Value>>(value))
+			for (const auto &pair : std::get<Object>(value))
 			{
 				result.push_back(pair.first);
 				for (const auto &sub_value : pair.second.to_string_array())
@@ -192,9 +190,9 @@ std::vector<std::string> Value::to_string_array() const noexcept
 
 std::string Value::pretty_print() const noexcept
 {
-	if (std::holds_alternative<std::string>(*this))
+	if (std::holds_alternative<String>(*this))
 	{
-		return '"' + std::get<std::string>(*this) + '"';
+		return '"' + std::get<String>(*this).get() + '"';
 	}
 	else if (std::holds_alternative<double>(*this))
 	{
@@ -206,11 +204,11 @@ std::string Value::pretty_print() const noexcept
 	{
 		return std::get<bool>(*this) ? "true" : "false";
 	}
-	else if (std::holds_alternative<std::vector<Value>>(*this))
+	else if (std::holds_alternative<Array>(*this))
 	{
 		std::string result = "[";
 		bool first = true;
-		for (const Value &value : std::get<std::vector<Value>>(*this))
+		for (const Value &value : std::get<Array>(*this))
 		{
 			if (!first)
 			{
@@ -222,11 +220,11 @@ std::string Value::pretty_print() const noexcept
 		result += "]";
 		return result;
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(*this))
+	else if (std::holds_alternative<Object>(*this))
 	{
 		std::string result = "{";
 		bool first = true;
-		for (const auto &pair : std::get<std::map<std::string, Value>>(*this))
+		for (const auto &pair : std::get<Object>(*this))
 		{
 			if (!first)
 			{
@@ -249,9 +247,9 @@ bool Value::operator==(const Value &rhs) const noexcept
 		return false;
 	}
 
-	if (std::holds_alternative<std::string>(*this))
+	if (std::holds_alternative<String>(*this))
 	{
-		return std::get<std::string>(*this) == std::get<std::string>(rhs);
+		return std::get<String>(*this) == std::get<String>(rhs);
 	}
 	else if (std::holds_alternative<double>(*this))
 	{
@@ -261,18 +259,305 @@ bool Value::operator==(const Value &rhs) const noexcept
 	{
 		return std::get<bool>(*this) == std::get<bool>(rhs);
 	}
-	else if (std::holds_alternative<std::vector<Value>>(*this))
+	else if (std::holds_alternative<Array>(*this))
+	{
+		return std::get<Array>(*this) == std::get<Array>(rhs);
+	}
+	else if (std::holds_alternative<Object>(*this))
+	{
+		return std::get<Object>(*this) == std::get<Object>(rhs);
+	}
+
+	return true;
+}
+
+static uint32_t key_hash(const std::string &key) noexcept
+{
+	return static_cast<uint32_t>(std::hash<std::string>()(key));
+}
+
+static bool key_less(const ObjectData::value_type &lhs, const ObjectData::value_type &rhs) noexcept
+{
+	return lhs.first < rhs.first;
+}
+
+ObjectData::ObjectData(const std::map<std::string, Value> &values)
+{
+	entries.reserve(values.size());
+	for (const auto &pair : values)
+	{
+		append(pair.first, pair.second);
+	}
+}
+
+ObjectData::ObjectData(std::initializer_list<value_type> values)
+{
+	entries.reserve(values.size());
+	for (const auto &pair : values)
+	{
+		insert_or_assign(pair.first, pair.second);
+	}
+}
+
+ObjectData::const_iterator ObjectData::begin() const noexcept
+{
+	sort();
+	return entries.begin();
+}
+
+ObjectData::const_iterator ObjectData::find(const std::string &key) const noexcept
+{
+	const size_t index = index_of(key);
+	return index < entries.size() ? entries.begin() + index : entries.end();
+}
+
+size_t ObjectData::count(const std::string &key) const noexcept
+{
+	return index_of(key) < entries.size();
+}
+
+const Value &ObjectData::at(const std::string &key) const
+{
+	const size_t index = index_of(key);
+	if (index >= entries.size())
+	{
+		throw std::out_of_range("ObjectData::at");
+	}
+	return entries[index].second;
+}
+
+Value &ObjectData::operator[](const std::string &key)
+{
+	size_t index = index_of(key);
+	if (index >= entries.size())
+	{
+		index = append(key, Null());
+	}
+	return entries[index].second;
+}
+
+std::pair<ObjectData::const_iterator, bool> ObjectData::insert_or_assign(const std::string &key, const Value &value)
+{
+	size_t index = index_of(key);
+	if (index < entries.size())
+	{
+		entries[index].second = value;
+		return {entries.begin() + index, false};
+	}
+
+	index = append(key, value);
+	return {entries.begin() + index, true};
+}
+
+bool ObjectData::operator==(const ObjectData &rhs) const noexcept
+{
+	if (size() != rhs.size())
+	{
+		return false;
+	}
+
+	for (const auto &[key, value] : entries)
+	{
+		const size_t index = rhs.index_of(key);
+		if (index >= rhs.entries.size() || rhs.entries[index].second != value)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ObjectData::operator<(const ObjectData &rhs) const noexcept
+{
+	return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+}
+
+size_t ObjectData::index_of(const std::string &key) const noexcept
+{
+	if (slots.empty())
+	{
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			if (entries[i].first == key)
+			{
+				return i;
+			}
+		}
+		return entries.size();
+	}
+
+	const uint32_t hash = key_hash(key);
+	const size_t mask = slots.size() - 1;
+	for (size_t i = hash & mask;; i = (i + 1) & mask)
+	{
+		const Slot &slot = slots[i];
+		if (slot.index == 0)
+		{
+			return entries.size();
+		}
+		if (slot.hash == hash && entries[slot.index - 1].first == key)
+		{
+			return slot.index - 1;
+		}
+	}
+}
+
+size_t ObjectData::append(const std::string &key, const Value &value)
+{
+	if (sorted == entries.size() && (entries.empty() || entries.back().first < key))
+	{
+		sorted++;
+	}
+
+	entries.emplace_back(key, value);
+	const size_t index = entries.size() - 1;
+
+	// Keep the table at most half full.
+	if (slots.size() >= entries.size() * 2)
+	{
+		place(index);
+	}
+	else if (entries.size() > SEARCH_LIMIT)
 	{
-		return std::get<std::vector<Value>>(*this) == std::get<std::vector<Value>>(rhs);
+		rehash(std::max<size_t>(32, slots.size() * 2));
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(*this))
+
+	return index;
+}
+
+void ObjectData::place(size_t index) const noexcept
+{
+	const uint32_t hash = key_hash(entries[index].first);
+	const size_t mask = slots.size() - 1;
+	size_t i = hash & mask;
+	while (slots[i].index != 0)
 	{
-		return std::get<std::map<std::string, Value>>(*this) == std::get<std::map<std::string, Value>>(rhs);
+		i = (i + 1) & mask;
 	}
+	slots[i] = {static_cast<uint32_t>(index + 1), hash};
+}
 
+void ObjectData::rehash(size_t capacity) const
+{
+	slots.assign(capacity, {0, 0});
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		place(i);
+	}
+}
+
+void ObjectData::sort() const
+{
+	if (sorted == entries.size())
+	{
+		return;
+	}
+
+	// The new keys are usually a small tail, so sort just those and merge them in.
+	const auto middle = entries.begin() + sorted;
+	std::sort(middle, entries.end(), key_less);
+	std::inplace_merge(entries.begin(), middle, entries.end(), key_less);
+	sorted = entries.size();
+
+	if (!slots.empty())
+	{
+		rehash(slots.size());
+	}
+}
+
+bool ArrayData::next_line(Value &line) const noexcept
+{
+	std::string text;
+	if (!lines->next(text))
+	{
+		return false;
+	}
+	line = std::move(text);
 	return true;
 }
 
+void ArrayData::read_lines() noexcept
+{
+	std::string text;
+	while (lines->next(text))
+	{
+		emplace_back(std::move(text));
+	}
+	lines.reset();
+}
+
+void ArrayData::fill_range() noexcept
+{
+	size_t count = range_count;
+	if (count > MAX_FILLED_RANGE)
+	{
+		std::cerr << "WARNING: Attempted to create an array with " << count << " elements (max is " << MAX_FILLED_RANGE << "). Array truncated." << std::endl;
+		count = MAX_FILLED_RANGE;
+	}
+
+	try
+	{
+		reserve(count);
+	}
+	catch (const std::bad_alloc &)
+	{
+		std::cerr << "ERROR: Not enough memory to create an array with " << count << " elements." << std::endl;
+		exit(1);
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		emplace_back(range_first_value + static_cast<double>(i));
+	}
+	range_count = 0;
+}
+
+static size_t hash_combine(size_t seed, size_t value) noexcept
+{
+	return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
+size_t Value::hash() const noexcept
+{
+	size_t result = index();
+
+	if (std::holds_alternative<String>(*this))
+	{
+		return hash_combine(result, std::hash<std::string>()(std::get<String>(*this).get()));
+	}
+	else if (std::holds_alternative<double>(*this))
+	{
+		// -0 and 0 are equal, so they have to hash the same.
+		double number = std::get<double>(*this);
+		return hash_combine(result, std::hash<double>()(number == 0 ? 0.0 : number));
+	}
+	else if (std::holds_alternative<bool>(*this))
+	{
+		return hash_combine(result, std::get<bool>(*this));
+	}
+	else if (std::holds_alternative<Array>(*this))
+	{
+		// Read ranges element by element, so they don't have to be filled in.
+		const ArrayData &array = std::get<Array>(*this).raw();
+		size_t length = array.length();
+		result = hash_combine(result, length);
+		for (size_t i = 0; i < length; ++i)
+		{
+			result = hash_combine(result, array.is_range() ? array.element(i).hash() : array[i].hash());
+		}
+	}
+	else if (std::holds_alternative<Object>(*this))
+	{
+		for (const auto &[key, value] : std::get<Object>(*this))
+		{
+			result = hash_combine(result, std::hash<std::string>()(key));
+			result = hash_combine(result, value.hash());
+		}
+	}
+
+	return result;
+}
+
 bool Value::operator!=(const Value &rhs) const noexcept
 {
 	return !(*this == rhs);
@@ -281,11 +566,11 @@ bool Value::operator!=(const Value &rhs) const noexcept
 void make_comparable(Value &lhs, Value &rhs) noexcept
 {
 	// Anything that's not a number or a string is cast to a string
-	if (!std::holds_alternative<std::string>(lhs) && !std::holds_alternative<double>(lhs))
+	if (!std::holds_alternative<String>(lhs) && !std::holds_alternative<double>(lhs))
 	{
 		lhs = lhs.to_string();
 	}
-	if (!std::holds_alternative<std::string>(rhs) && !std::holds_alternative<double>(rhs))
+	if (!std::holds_alternative<String>(rhs) && !std::holds_alternative<double>(rhs))
 	{
 		rhs = rhs.to_string();
 	}
@@ -293,7 +578,7 @@ void make_comparable(Value &lhs, Value &rhs) noexcept
 	// If one of the two is a string, the other is cast to a string
 	if (lhs.index() != rhs.index())
 	{
-		if (std::holds_alternative<std::string>(lhs))
+		if (std::holds_alternative<String>(lhs))
 		{
 			rhs = rhs.to_string();
 		}
@@ -307,11 +592,11 @@ void make_comparable(Value &lhs, Value &rhs) noexcept
 bool Value::operator<(const Value &rhs) const noexcept
 {
 	// Arrays, objects, and null cannot be compared.
-	if (std::holds_alternative<std::vector<Value>>(*this) || std::holds_alternative<std::vector<Value>>(rhs))
+	if (std::holds_alternative<Array>(*this) || std::holds_alternative<Array>(rhs))
 	{
 		return false;
 	}
-	else if (std::holds_alternative<std::map<std::string, Value>>(*this) || std::holds_alternative<std::map<std::string, Value>>(rhs))
+	else if (std::holds_alternative<Object>(*this) || std::holds_alternative<Object>(rhs))
 	{
 		return false;
 	}
@@ -320,7 +605,7 @@ bool Value::operator<(const Value &rhs) const noexcept
 		return false;
 	}
 
-	if (std::holds_alternative<std::string>(*this) || std::holds_alternative<std::string>(rhs))
+	if (std::holds_alternative<String>(*this) || std::holds_alternative<String>(rhs))
 	{
 		return to_string() < rhs.to_string();
 	}
@@ -4,25 +4,327 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <memory>
 
 class Null
 {
 };
 
-class Value : public std::variant<Null, bool, double, std::string, std::vector<Value>, std::map<std::string, Value>>
+class Value;
+class ArrayData;
+class ObjectData;
+class LineStream;
+
+// Reference-counted, copy-on-write handle to a container.
+// Copying a handle only bumps the reference count, so values can be pushed, popped and
+// stored in variables without copying their contents.
+// Reads go through the const interface; mut() gives write access, first making a private copy
+// if the contents are shared with any other handle.
+// Arrays may also be lazy ranges or streams (see ArrayData), which are filled in the first time their elements are read.
+// The count is stored next to the contents, so a handle is a single pointer and a Value fits in 16 bytes.
+// Values are only ever used by one thread, so the count doesn't need to be atomic.
+template <typename T>
+class Shared
+{
+public:
+	Shared() noexcept {}
+	Shared(const T &value) : data(new Node(value)) {}
+	Shared(T &&value) : data(new Node(std::move(value))) {}
+
+	template <typename U, typename = std::enable_if_t<std::is_convertible_v<U, T> && !std::is_same_v<std::decay_t<U>, T> && !std::is_same_v<std::decay_t<U>, Shared>>>
+	Shared(U &&value) : data(new Node(T(std::forward<U>(value)))) {}
+
+	Shared(const Shared &other) noexcept : data(other.data)
+	{
+		if (data)
+		{
+			data->references++;
+		}
+	}
+
+	Shared(Shared &&other) noexcept : data(other.data)
+	{
+		other.data = nullptr;
+	}
+
+	Shared &operator=(const Shared &other) noexcept
+	{
+		Shared copy(other);
+		std::swap(data, copy.data);
+		return *this;
+	}
+
+	Shared &operator=(Shared &&other) noexcept
+	{
+		std::swap(data, other.data);
+		return *this;
+	}
+
+	~Shared()
+	{
+		if (data && --data->references == 0)
+		{
+			delete data;
+		}
+	}
+
+	const T &get() const noexcept
+	{
+		if (!data)
+		{
+			return empty_value();
+		}
+
+		if constexpr (std::is_same_v<T, ArrayData>)
+		{
+			data->value.materialize();
+		}
+		return data->value;
+	}
+
+	// The contents as they are stored, without filling in a lazy range.
+	// A stream is still read in full, since its length isn't known until then.
+	const T &raw() const noexcept
+	{
+		if constexpr (std::is_same_v<T, ArrayData>)
+		{
+			if (data && data->value.is_stream())
+			{
+				data->value.materialize();
+			}
+		}
+		return data ? data->value : empty_value();
+	}
+
+	// The contents exactly as they are stored, including a stream that hasn't been read yet.
+	const T &lazy() const noexcept
+	{
+		return data ? data->value : empty_value();
+	}
+
+	// Whether this is the only handle to the contents.
+	bool unique() const noexcept
+	{
+		return !data || data->references == 1;
+	}
+
+	T &mut()
+	{
+		if (!data)
+		{
+			data = new Node(T());
+		}
+		else
+		{
+			if constexpr (std::is_same_v<T, ArrayData>)
+			{
+				data->value.materialize();
+			}
+
+			if (data->references > 1)
+			{
+				Node *copy = new Node(data->value);
+				data->references--;
+				data = copy;
+			}
+		}
+		return data->value;
+	}
+
+	operator const T &() const noexcept { return get(); }
+	const T &operator*() const noexcept { return get(); }
+	const T *operator->() const noexcept { return &get(); }
+
+	auto size() const noexcept
+	{
+		if constexpr (std::is_same_v<T, ArrayData>)
+		{
+			return raw().length();
+		}
+		else
+		{
+			return get().size();
+		}
+	}
+	bool empty() const noexcept { return size() == 0; }
+	auto begin() const noexcept { return get().begin(); }
+	auto end() const noexcept { return get().end(); }
+	auto rbegin() const noexcept { return get().rbegin(); }
+	auto rend() const noexcept { return get().rend(); }
+	decltype(auto) front() const noexcept { return get().front(); }
+	decltype(auto) back() const noexcept { return get().back(); }
+
+	template <typename K>
+	decltype(auto) operator[](const K &key) const noexcept { return get()[key]; }
+
+	template <typename K>
+	auto find(const K &key) const noexcept { return get().find(key); }
+
+	template <typename K>
+	auto count(const K &key) const noexcept { return get().count(key); }
+
+	template <typename K>
+	decltype(auto) at(const K &key) const { return get().at(key); }
+
+	bool operator==(const Shared &rhs) const noexcept
+	{
+		return data == rhs.data || get() == rhs.get();
+	}
+
+	bool operator!=(const Shared &rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	bool operator<(const Shared &rhs) const noexcept { return get() < rhs.get(); }
+	bool operator<=(const Shared &rhs) const noexcept { return get() <= rhs.get(); }
+	bool operator>(const Shared &rhs) const noexcept { return get() > rhs.get(); }
+	bool operator>=(const Shared &rhs) const noexcept { return get() >= rhs.get(); }
+
+private:
+	struct Node
+	{
+		explicit Node(const T &value) : value(value) {}
+		explicit Node(T &&value) noexcept : value(std::move(value)) {}
+
+		T value;
+		size_t references = 1;
+	};
+
+	static const T &empty_value() noexcept
+	{
+		static const T value;
+		return value;
+	}
+
+	Node *data = nullptr;
+};
+
+// The elements of an array.
+// A range of consecutive integers (see arrayslice) can be stored as just its bounds.
+// Code that knows about ranges can use them as they are, through Array::raw();
+// anything else reads the elements through Array::get(), which fills them in once, on first use.
+// An array can also be the lines of a running command's output (see cmd_lines). A loop reads them one at a time
+// through Array::lazy(), so they never all have to be in memory; anything else reads the rest of them in at once.
+class ArrayData : public std::vector<Value>
+{
+public:
+	ArrayData() noexcept {}
+	ArrayData(const std::vector<Value> &values);
+	ArrayData(std::vector<Value> &&values) noexcept;
+
+	// The integers from `first` to `first + count - 1`.
+	static ArrayData range(double first, size_t count) noexcept;
+
+	// The lines of a command's output, read as they're needed.
+	static ArrayData stream(std::shared_ptr<LineStream> lines) noexcept;
+
+	bool is_range() const noexcept { return range_count > 0; }
+	double range_first() const noexcept { return range_first_value; }
+
+	bool is_stream() const noexcept { return lines != nullptr; }
+
+	// Read the next line of a stream, which must not have been filled in yet.
+	// Returns false once there are no more lines.
+	bool next_line(Value &line) const noexcept;
+
+	// The number of elements, whether or not they have been filled in.
+	size_t length() const noexcept { return is_range() ? range_count : size(); }
+
+	// The element at a (0-based) index, which must be less than length().
+	Value element(size_t index) const noexcept;
+
+	// Fill in the elements of a range or stream, so it can be used like any other array.
+	// A range longer than MAX_FILLED_RANGE is truncated (with a warning), since all of its elements would have to fit in memory.
+	void materialize() noexcept;
+
+	static constexpr size_t MAX_FILLED_RANGE = 1 << 24;
+
+private:
+	double range_first_value = 0;
+	size_t range_count = 0;
+	std::shared_ptr<LineStream> lines;
+
+	void read_lines() noexcept;
+	void fill_range() noexcept;
+};
+
+// The keys and values of an object.
+// Keys are found through an open-addressing hash table, but iteration always goes in key order
+// (like the std::map that objects used to be), so the output of keys(), pairs() and json_encode() is stable.
+// New keys are appended, and only sorted into place the next time the object is iterated.
+// Small objects skip the hash table and are just searched.
+class ObjectData
 {
 public:
-	using std::variant<Null, bool, double, std::string, std::vector<Value>, std::map<std::string, Value>>::variant;
+	using value_type = std::pair<std::string, Value>;
+	using const_iterator = std::vector<value_type>::const_iterator;
+
+	ObjectData() noexcept {}
+	ObjectData(const std::map<std::string, Value> &values);
+	ObjectData(std::initializer_list<value_type> values);
+
+	size_t size() const noexcept { return entries.size(); }
+	bool empty() const noexcept { return entries.empty(); }
+
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept { return entries.end(); }
 
-	Value(int value) noexcept : std::variant<Null, bool, double, std::string, std::vector<Value>, std::map<std::string, Value>>(static_cast<double>(value)) {}
-	Value(std::initializer_list<Value> values) noexcept : std::variant<Null, bool, double, std::string, std::vector<Value>, std::map<std::string, Value>>(std::vector<Value>(values)) {}
+	const_iterator find(const std::string &key) const noexcept;
+	size_t count(const std::string &key) const noexcept;
+	const Value &at(const std::string &key) const;
 
-	bool is_null() const noexcept;
+	Value &operator[](const std::string &key);
+	std::pair<const_iterator, bool> insert_or_assign(const std::string &key, const Value &value);
+
+	bool operator==(const ObjectData &rhs) const noexcept;
+	bool operator<(const ObjectData &rhs) const noexcept;
+
+private:
+	// A position in the hash table. Index 0 means the slot is empty; otherwise it's entries[index - 1].
+	struct Slot
+	{
+		uint32_t index;
+		uint32_t hash;
+	};
+
+	static constexpr size_t SEARCH_LIMIT = 8;
+
+	size_t index_of(const std::string &key) const noexcept;
+	size_t append(const std::string &key, const Value &value);
+	void place(size_t index) const noexcept;
+	void rehash(size_t capacity) const;
+	void sort() const;
+
+	// Sorting only reorders the entries (and so rebuilds the table), which doesn't change what the object contains.
+	mutable std::vector<value_type> entries;
+	mutable std::vector<Slot> slots;
+
+	// entries[0, sorted) are already in key order.
+	mutable size_t sorted = 0;
+};
+
+using String = Shared<std::string>;
+using Array = Shared<ArrayData>;
+using Object = Shared<ObjectData>;
+
+class Value : public std::variant<Null, bool, double, String, Array, Object>
+{
+public:
+	using std::variant<Null, bool, double, String, Array, Object>::variant;
+
+	Value(int value) noexcept : std::variant<Null, bool, double, String, Array, Object>(static_cast<double>(value)) {}
+	Value(std::initializer_list<Value> values) noexcept : std::variant<Null, bool, double, String, Array, Object>(std::vector<Value>(values)) {}
+
+	bool is_null() const noexcept { return std::holds_alternative<Null>(*this); }
 	bool to_bool() const noexcept;
 	double to_number() const noexcept;
 	std::string to_string() const noexcept;
 	std::vector<Value> to_array() const noexcept;
-	std::map<std::string, Value> to_object() const noexcept;
+	ObjectData to_object() const noexcept;
 
 	std::vector<std::string> to_string_array() const noexcept;
 
@@ -31,6 +333,65 @@ public:
 	bool operator==(const Value &rhs) const noexcept;
 	bool operator!=(const Value &rhs) const noexcept;
 	bool operator<(const Value &rhs) const noexcept;
+
+	// A hash of the contents, consistent with operator==.
+	size_t hash() const noexcept;
 };
 
+namespace std
+{
+	template <>
+	struct hash<Value>
+	{
+		size_t operator()(const Value &value) const noexcept { return value.hash(); }
+	};
+}
+
+// Containers are stored behind a single pointer, so a value is just that (or a number) and a type tag.
+static_assert(sizeof(Value) <= 16, "Value should fit in 16 bytes");
+
 void make_comparable(Value &lhs, Value &rhs) noexcept;
+
+inline ArrayData::ArrayData(const std::vector<Value> &values) : std::vector<Value>(values) {}
+
+inline ArrayData::ArrayData(std::vector<Value> &&values) noexcept : std::vector<Value>(std::move(values)) {}
+
+inline ArrayData ArrayData::range(double first, size_t count) noexcept
+{
+	ArrayData result;
+	result.range_first_value = first;
+	result.range_count = count;
+	return result;
+}
+
+inline Value ArrayData::element(size_t index) const noexcept
+{
+	if (is_range())
+	{
+		return range_first_value + static_cast<double>(index);
+	}
+	return (*this)[index];
+}
+
+inline ArrayData ArrayData::stream(std::shared_ptr<LineStream> lines) noexcept
+{
+	ArrayData result;
+	result.lines = std::move(lines);
+	return result;
+}
+
+inline void ArrayData::materialize() noexcept
+{
+	if (is_stream())
+	{
+		read_lines();
+		return;
+	}
+
+	if (!is_range())
+	{
+		return;
+	}
+
+	fill_range();
+}
@@ -1,25 +1,83 @@
 #include "variables.hpp"
+#include "intern.hpp"
+
+size_t Variables::slot(const std::string &key) noexcept
+{
+	const auto it = names.find(key);
+	if (it != names.end())
+	{
+		return it->second;
+	}
+
+	const size_t slot = slots.size();
+	slots.push_back({key, Null(), false});
+	names.emplace(key, slot);
+	return slot;
+}
+
+size_t Variables::slot(const String &key) noexcept
+{
+	const std::string *address = &key.raw();
+	const auto it = interned_names.find(address);
+	if (it != interned_names.end())
+	{
+		return it->second;
+	}
+
+	const size_t slot = this->slot(key.raw());
+	if (is_interned(key))
+	{
+		interned_names.emplace(address, slot);
+	}
+	return slot;
+}
 
 Value Variables::get(const std::string &key) const noexcept
 {
-	if (!has(key))
+	const auto it = names.find(key);
+	if (it == names.end())
 	{
 		return Null();
 	}
-	return at(key);
+	return slots[it->second].value;
 }
 
 void Variables::set(const std::string &key, const Value &value) noexcept
 {
-	(*this)[key] = value;
+	set(slot(key), value);
 }
 
 bool Variables::has(const std::string &key) const noexcept
 {
-	return find(key) != end();
+	const auto it = names.find(key);
+	return it != names.end() && slots[it->second].defined;
 }
 
 Value &Variables::get_ref(const std::string &key)
 {
-	return (*this)[key];
+	auto &slot = slots[this->slot(key)];
+	slot.defined = true;
+	return slot.value;
+}
+
+void Variables::erase(const std::string &key) noexcept
+{
+	const auto it = names.find(key);
+	if (it != names.end())
+	{
+		erase(it->second);
+	}
+}
+
+ObjectData Variables::to_object() const noexcept
+{
+	ObjectData result;
+	for (const auto &slot : slots)
+	{
+		if (slot.defined)
+		{
+			result.insert_or_assign(slot.name, slot.value);
+		}
+	}
+	return result;
 }
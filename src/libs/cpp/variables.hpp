@@ -2,17 +2,78 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "value.hpp"
 
-struct Variables : public std::map<std::string, Value>
+// Slot numbers for the read-only special variables (see actions/get.cpp).
+enum SpecialVariable : int
 {
-	using std::map<std::string, Value>::map;
+	VAR_PARAMS = -1,   // @
+	VAR_COMMANDS = -2, // $
+	VAR_VARS = -3,     // _VARS
+	VAR_VERSION = -4,  // _VERSION
+};
+
+// Variables are stored in a flat array of slots.
+// Bytecode operands are resolved to slot numbers when the program is loaded,
+// so the name table is only needed when a variable is looked up by name at run time.
+class Variables
+{
+public:
+	// Get the slot for a variable name, creating an (undefined) slot if needed.
+	size_t slot(const std::string &key) noexcept;
+
+	// The same, for a name that is usually an interned constant (see intern.hpp).
+	// Interned names are remembered by address, so finding them again doesn't hash the name.
+	size_t slot(const String &key) noexcept;
+
+	const Value &operator[](size_t slot) const noexcept
+	{
+		return slots[slot].value;
+	}
+
+	bool has(size_t slot) const noexcept
+	{
+		return slots[slot].defined;
+	}
+
+	void set(size_t slot, Value value) noexcept
+	{
+		slots[slot].value = std::move(value);
+		slots[slot].defined = true;
+	}
+
+	void erase(size_t slot) noexcept
+	{
+		slots[slot].value = Null();
+		slots[slot].defined = false;
+	}
 
 	Value get(const std::string &key) const noexcept;
 	void set(const std::string &key, const Value &value) noexcept;
-
 	bool has(const std::string &key) const noexcept;
-
 	Value &get_ref(const std::string &key);
+	Value &get_ref(size_t slot) noexcept
+	{
+		slots[slot].defined = true;
+		return slots[slot].value;
+	}
+	void erase(const std::string &key) noexcept;
+
+	// All defined variables, keyed by name.
+	ObjectData to_object() const noexcept;
+
+private:
+	struct Slot
+	{
+		std::string name;
+		Value value;
+		bool defined;
+	};
+
+	std::vector<Slot> slots;
+	std::unordered_map<std::string, size_t> names;
+	std::unordered_map<const std::string *, size_t> interned_names;
 };
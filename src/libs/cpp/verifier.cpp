@@ -0,0 +1,364 @@
+#include "verifier.hpp"
+#include "actions.hpp"
+#include "functions/add.hpp"
+#include "functions/arrayindex.hpp"
+#include "functions/arrayslice.hpp"
+#include "functions/bitwise_and.hpp"
+#include "functions/bitwise_or.hpp"
+#include "functions/bitwise_xor.hpp"
+#include "functions/booland.hpp"
+#include "functions/boolor.hpp"
+#include "functions/boolxor.hpp"
+#include "functions/concat.hpp"
+#include "functions/div.hpp"
+#include "functions/equal.hpp"
+#include "functions/explode.hpp"
+#include "functions/greater.hpp"
+#include "functions/greaterequal.hpp"
+#include "functions/implode.hpp"
+#include "functions/inarray.hpp"
+#include "functions/jump.hpp"
+#include "functions/jumpiffalse.hpp"
+#include "functions/jumpifnil.hpp"
+#include "functions/less.hpp"
+#include "functions/lessequal.hpp"
+#include "functions/mul.hpp"
+#include "functions/notequal.hpp"
+#include "functions/pow.hpp"
+#include "functions/rem.hpp"
+#include "functions/strlike.hpp"
+#include "functions/sub.hpp"
+#include "functions/superimplode.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// How an instruction changes the stack: it pops some values, then pushes some.
+// Pops on an empty stack are harmless (they give null), so the depth never goes below zero.
+struct StackEffect
+{
+	int pops;
+	int pushes;
+};
+
+// Pops everything, as far as the verifier is concerned.
+static const int POP_ALL = std::numeric_limits<int>::max();
+
+static const int UNREACHED = -1;
+
+// Get the stack effect of a builtin function.
+// Returns false if the call can jump somewhere that isn't known until run time.
+static bool call_effect(Function function, int arg, StackEffect &effect) noexcept
+{
+	if (function == jump || function == jumpifnil || function == jumpiffalse)
+	{
+		// Jumps with a constant target are lowered to native opcodes,
+		// so any left over pop their target off the stack.
+		return false;
+	}
+
+	if (function == explode)
+	{
+		// Pushes however many elements the array has, which may be none.
+		effect = {1, 0};
+	}
+	else if (function == implode || function == superimplode || function == concat)
+	{
+		effect = {arg, 1};
+	}
+	else if (function == add || function == sub || function == mul || function == rem ||
+			 function == static_cast<Function>(div) || function == static_cast<Function>(pow) ||
+			 function == arrayindex || function == arrayslice || function == inarray || function == strlike ||
+			 function == booland || function == boolor || function == boolxor ||
+			 function == bitwise_and || function == bitwise_or || function == bitwise_xor ||
+			 function == equal || function == notequal ||
+			 function == greater || function == greaterequal || function == less || function == lessequal)
+	{
+		effect = {2, 1};
+	}
+	else
+	{
+		// Unary operators, and functions that take a params array.
+		effect = {1, 1};
+	}
+
+	return true;
+}
+
+// The stack effect of running one instruction and then another.
+static StackEffect compose(const StackEffect &first, const StackEffect &second) noexcept
+{
+	if (first.pushes >= second.pops)
+	{
+		return {first.pops, first.pushes - second.pops + second.pushes};
+	}
+
+	return {first.pops + second.pops - first.pushes, second.pushes};
+}
+
+// Get the stack effect of an instruction that falls through to the next one.
+// Returns false if the effect can't be known statically.
+static bool stack_effect(const Instruction &instruction, StackEffect &effect) noexcept
+{
+	switch (instruction.opcode)
+	{
+	case OP_CALL:
+		return call_effect(FUNCTIONS[instruction.operand0], instruction.operand1, effect);
+	case OP_CALL_ARGS:
+		effect = {instruction.operand1, 1};
+		return true;
+	case OP_CALL_SET:
+		if (!call_effect(FUNCTIONS[instruction.operand0], 0, effect))
+		{
+			return false;
+		}
+		effect = compose(effect, {1, 0});
+		return true;
+	case OP_GET_GET:
+	case OP_GET_PUSH:
+	case OP_PUSH_GET:
+	case OP_PUSH_PUSH:
+		effect = {0, 2};
+		return true;
+	case OP_SET_GET:
+		effect = {1, 1};
+		return true;
+	case OP_ITER_BEGIN:
+		effect = {1, 2};
+		return true;
+	case OP_SLICE:
+		effect = {3, 1};
+		return true;
+	case OP_SET:
+	case OP_POP:
+	case OP_RUN_COMMAND:
+	case OP_DESTRUCTURE:
+		effect = {1, 0};
+		return true;
+	case OP_GET:
+	case OP_PUSH:
+	case OP_PUSH_CMD_RESULT:
+	case OP_COPY:
+	case OP_SET_CACHE:
+	case OP_GET_EXCEPTION_TYPE:
+		effect = {0, 1};
+		return true;
+	case OP_DELETE_VAR:
+	case OP_SWAP:
+	case OP_DELETE_CACHE:
+		effect = {0, 0};
+		return true;
+	case OP_POP_UNTIL_NULL:
+		effect = {POP_ALL, 0};
+		return true;
+	case OP_VARIABLE_INSERT:
+		effect = {3, 0};
+		return true;
+	case OP_PUSH_EXCEPTION:
+		effect = {instruction.operand1 ? 2 : 1, 1};
+		return true;
+	}
+
+	return false;
+}
+
+// Check that every operand refers to something that exists.
+static bool verify_operands(const VirtualMachine &vm) noexcept
+{
+	const size_t count = vm.instructions.size();
+	const size_t const_count = vm.const_lookup.size();
+
+	const auto is_target = [count](int target)
+	{
+		return target >= 0 && (size_t)target <= count;
+	};
+
+	const auto is_const = [const_count](int id)
+	{
+		return id >= 0 && (size_t)id < const_count;
+	};
+
+	for (const auto &instruction : vm.instructions)
+	{
+		const int op0 = instruction.operand0;
+		const int op1 = instruction.operand1;
+
+		if (instruction.opcode == 0 || instruction.opcode > OPERATION_COUNT)
+		{
+			return false;
+		}
+
+		switch (instruction.opcode)
+		{
+		case OP_GET:
+		case OP_SET:
+		case OP_DELETE_VAR:
+		case OP_PUSH:
+		case OP_DESTRUCTURE:
+			if (!is_const(op0))
+			{
+				return false;
+			}
+			break;
+		case OP_PUSH_EXCEPTION:
+			if (!op1 && !is_const(op0))
+			{
+				return false;
+			}
+			break;
+		case OP_CALL:
+		case OP_CALL_ARGS:
+		case OP_CALL_SET:
+			if (op0 < 0 || op0 >= FUNCTION_COUNT || (instruction.opcode == OP_CALL_ARGS && op1 < 0))
+			{
+				return false;
+			}
+			break;
+		case OP_JUMP:
+		case OP_JUMP_IF_FALSE:
+		case OP_JUMP_IF_NIL:
+		case OP_PUSH_CATCH_LOC:
+		case OP_POP_JUMP_IF_FALSE:
+		case OP_JUMP_IF_NIL_SET:
+		case OP_ITER_NEXT:
+		case OP_ITER_NEXT_SET:
+			if (!is_target(op0))
+			{
+				return false;
+			}
+			break;
+		case OP_GET_CACHE_ELSE_JUMP:
+			if (!is_target(op1))
+			{
+				return false;
+			}
+			break;
+		case OP_COPY:
+			if (op0 < 0)
+			{
+				return false;
+			}
+			break;
+		}
+	}
+
+	return true;
+}
+
+// Find a lower bound on the stack depth before each instruction, by following every
+// control-flow edge until the bounds stop changing. Then make sure that copy and swap
+// always have enough values to work with.
+static bool verify_stack(const VirtualMachine &vm) noexcept
+{
+	const size_t count = vm.instructions.size();
+
+	std::vector<int> depth(count + 1, UNREACHED);
+	std::vector<size_t> work;
+
+	const auto flow = [&](size_t target, int new_depth)
+	{
+		new_depth = std::max(new_depth, 0);
+		if (depth[target] == UNREACHED || new_depth < depth[target])
+		{
+			depth[target] = new_depth;
+			work.push_back(target);
+		}
+	};
+
+	flow(vm.instruction_index, 0);
+
+	while (!work.empty())
+	{
+		const size_t i = work.back();
+		work.pop_back();
+
+		if (i == count)
+		{
+			continue;
+		}
+
+		const auto &instruction = vm.instructions[i];
+		const int d = depth[i];
+
+		switch (instruction.opcode)
+		{
+		case OP_JUMP:
+			flow(instruction.operand0, d);
+			break;
+		case OP_JUMP_IF_FALSE:
+		case OP_JUMP_IF_NIL:
+			flow(instruction.operand0, d);
+			flow(i + 1, d);
+			break;
+		case OP_POP_JUMP_IF_FALSE:
+			flow(instruction.operand0, d - 1);
+			flow(i + 1, d - 1);
+			break;
+		case OP_JUMP_IF_NIL_SET:
+			flow(instruction.operand0, d);
+			flow(i + 1, d - 1);
+			break;
+		case OP_ITER_NEXT:
+			// Finishing the loop pops the iterator.
+			flow(instruction.operand0, d - 2);
+			flow(i + 1, d + 1);
+			break;
+		case OP_ITER_NEXT_SET:
+			flow(instruction.operand0, d - 2);
+			flow(i + 1, d);
+			break;
+		case OP_GET_CACHE_ELSE_JUMP:
+			flow(instruction.operand1, d);
+			flow(i + 1, d + 1);
+			break;
+		case OP_PUSH_CATCH_LOC:
+			// Catching an exception restores the stack to its current depth, then pushes the error.
+			flow(instruction.operand0, d + 1);
+			flow(i + 1, d);
+			break;
+		case OP_PUSH_INDEX:
+			// Subroutine calls are always push_index then a jump into the subroutine.
+			// The subroutine returns to just after the jump, with its params dropped from the stack.
+			if (i + 1 >= count || vm.instructions[i + 1].opcode != OP_JUMP)
+			{
+				return false;
+			}
+			flow(i + 1, d);
+			flow(i + 2, d - 1);
+			break;
+		case OP_POP_GOTO_INDEX:
+		case OP_THROW_EXCEPTION:
+			// Where these go is covered by the push_index and push_catch_loc edges.
+			break;
+		default:
+			StackEffect effect;
+			if (!stack_effect(instruction, effect))
+			{
+				return false;
+			}
+			flow(i + 1, std::max(d - effect.pops, 0) + effect.pushes);
+		}
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto &instruction = vm.instructions[i];
+
+		if (instruction.opcode == OP_COPY && (depth[i] == UNREACHED || depth[i] <= instruction.operand0))
+		{
+			return false;
+		}
+
+		if (instruction.opcode == OP_SWAP && (depth[i] == UNREACHED || depth[i] < 2))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool verify(const VirtualMachine &vm) noexcept
+{
+	return verify_operands(vm) && verify_stack(vm);
+}
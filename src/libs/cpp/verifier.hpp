@@ -0,0 +1,9 @@
+#pragma once
+
+#include "virtual_machine.hpp"
+
+// Check, once, everything that the interpreter would otherwise have to check on every instruction:
+// that opcodes, jump targets, constant indices and function indices are all in range,
+// and that `copy` and `swap` can never run with too few values on the stack.
+// If this returns true, the program can safely run with those checks turned off.
+bool verify(const VirtualMachine &vm) noexcept;
@@ -12,6 +12,11 @@ void VirtualMachine::warn(const std::string &message) const noexcept
 	std::cerr << "WARNING: " << message << std::endl;
 }
 
+int VirtualMachine::line_number(size_t index) const noexcept
+{
+	return (index < line_numbers.size()) ? line_numbers[index] : 0;
+}
+
 Value &VirtualMachine::get_const(size_t id) noexcept
 {
 	if (id >= const_lookup.size())
@@ -3,6 +3,9 @@
 #include "stack.hpp"
 #include "variables.hpp"
 #include "instruction.hpp"
+#include "functions.hpp"
+#include "memo_cache.hpp"
+#include "constants.hpp"
 #include <random>
 #include <vector>
 
@@ -27,19 +30,29 @@ struct VirtualMachine
 	std::mt19937_64 rng;
 	size_t instruction_index;
 	std::vector<Instruction> instructions;
-	std::vector<Value> const_lookup;
+
+	// Source line of each instruction.
+	const std::vector<int> &line_numbers;
+
+	ConstantPool const_lookup;
 
 	bool sandboxed;
 	const std::string &version;
 
 	Value last_cmd_result;
-	std::map<size_t, std::map<std::string, Value>> cache;
+	std::map<size_t, MemoCache> cache;
 	std::vector<ReturnInfo> return_indices;
 	std::vector<ExceptStackInfo> except_stack;
 
 	std::vector<Value> argv;
 
+	// Builtin function for each call instruction, resolved when the program is loaded.
+	std::vector<Function> call_table;
+
 	void error(const std::string &message) const noexcept;
 	void warn(const std::string &message) const noexcept;
 	Value &get_const(size_t id) noexcept;
+
+	// Get the source line of an instruction, for reporting errors.
+	int line_number(size_t index) const noexcept;
 };
@@ -0,0 +1,9 @@
+local proc = require 'src.util.processes'
+
+return function(vm)
+	local results = std.array()
+	for i, handle in ipairs(vm.pop()[1]) do
+		results[i] = proc.await(std.num(handle))
+	end
+	vm.push(results)
+end
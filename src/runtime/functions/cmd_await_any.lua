@@ -0,0 +1,3 @@
+local proc = require 'src.util.processes'
+
+return function(vm) vm.push(proc.await_any(vm.pop()[1])) end
@@ -0,0 +1,6 @@
+local proc = require 'src.util.processes'
+
+return function(vm)
+	local v = vm.pop()
+	vm.push(proc.pipe(v[1], v[2]))
+end
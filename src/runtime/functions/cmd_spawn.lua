@@ -0,0 +1,6 @@
+local proc = require 'src.util.processes'
+
+return function(vm)
+	local v = vm.pop()
+	vm.push(proc.spawn(v[1], math.max(1, v[2] and std.num(v[2]) or proc.cores())))
+end
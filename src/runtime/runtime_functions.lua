@@ -203,6 +203,12 @@ local functions = {
 	require 'src.runtime.functions.file_stat',
 	require 'src.runtime.functions.file_copy',
 	require 'src.runtime.functions.file_move',
+	require 'src.runtime.functions.cmd_spawn',
+	require 'src.runtime.functions.cmd_await',
+	require 'src.runtime.functions.cmd_await_any',
+	require 'src.runtime.functions.cmd_await_all',
+	require 'src.runtime.functions.cmd_lines',
+	require 'src.runtime.functions.cmd_pipe',
 	--[[/minify-delete]]
 }
 
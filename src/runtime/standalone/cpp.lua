@@ -1,5 +1,49 @@
 local fs = require 'src.util.filesystem'
 local log = require 'src.log'
+require 'src.compiler.functions.params'
+
+--Bytecode instruction ids, matching the `bc` table in codegen.lua.
+--Ids past the end of that table are opcodes that only the C++ runtime understands.
+local OP = {
+	call = 1,
+	set = 2,
+	get = 3,
+	push = 4,
+	pop = 5,
+	run_command = 6,
+	push_cmd_result = 7,
+	push_index = 8,
+	pop_goto_index = 9,
+	copy = 10,
+	delete_var = 11,
+	swap = 12,
+	pop_until_null = 13,
+	get_cache_else_jump = 14,
+	set_cache = 15,
+	delete_cache = 16,
+	push_catch_loc = 17,
+	variable_insert = 18,
+	destructure = 19,
+	get_exception_type = 20,
+	push_exception = 21,
+	throw_exception = 22,
+	jump = 23,
+	jumpiffalse = 24,
+	jumpifnil = 25,
+	call_args = 26,
+	get_get = 27,
+	get_push = 28,
+	push_get = 29,
+	push_push = 30,
+	set_get = 31,
+	call_set = 32,
+	pop_jump_if_false = 33,
+	jump_if_nil_set = 34,
+	iter_begin = 35,
+	iter_next = 36,
+	iter_next_set = 37,
+	slice = 38,
+}
 
 ---@diagnostic disable-next-line
 STANDALONE.cpp = {
@@ -8,62 +52,595 @@ STANDALONE.cpp = {
 	--- @param bytecode table Paisley bytecode.
 	--- @return string program_text The generated C++ program.
 	generate = function(bytecode)
-		local text = "#include \"PAISLEY_BYTECODE.hpp\"\n\n"
-		text = text .. "const std::vector<Instruction> INSTRUCTIONS = {\n"
+		bytecode = STANDALONE.cpp.lower(bytecode)
+
+		local native_includes, native_text = '', 'void (*const NATIVE_PROGRAM)(VirtualMachine &) = nullptr;\n'
+		---@diagnostic disable-next-line
+		if CPP_NATIVE then
+			native_includes, native_text = STANDALONE.cpp.native(bytecode)
+		end
+
+		local text = "#include \"PAISLEY_BYTECODE.hpp\"\n" .. native_includes .. "\n"
+		--Instructions are packed into 8 bytes, which leaves 24 bits for the first operand.
+		local max_operand = 2 ^ 23 - 1
+
+		text = text .. "std::vector<Instruction> INSTRUCTIONS = {\n"
 		for i = 1, #bytecode - 1 do
 			local instr = bytecode[i]
+			local operand = tonumber(instr[3]) or 0
+			if operand > max_operand or operand < -max_operand - 1 then
+				log.error('Program is too large for the C++ runtime (operand `' .. operand .. '` is out of range).')
+				os.exit(1)
+			end
+
 			text = text .. '\t{ ' ..
 				(tonumber(instr[1]) or 0) .. ', ' ..
-				(tonumber(instr[2]) or 0) .. ', ' ..
-				(tonumber(instr[3]) or 0) .. ', ' ..
+				operand .. ', ' ..
 				(tonumber(instr[4]) or 0) .. ' },\n'
 		end
 
+		--Line numbers are only needed for errors, so they're kept out of the instruction stream.
+		text = text .. "};\n\nconst std::vector<int> LINE_NUMBERS = {\n"
+		for i = 1, #bytecode - 1 do
+			text = text .. '\t' .. (tonumber(bytecode[i][2]) or 0) .. ',\n'
+		end
+
 		local function escape_str(str)
 			return '"' ..
 				str:gsub('\\', '\\\\'):gsub('\n', '\\n'):gsub('\r', '\\r'):gsub('"', '\\"'):gsub('\0', '\\0') .. '"s'
 		end
 
-		local function value_to_cpp(value)
+		--Constants are stored as one binary blob, which the runtime decodes lazily (see constants.cpp for the format).
+		--A string literal is much faster to compile than nested initializer lists, and costs nothing at startup.
+		local function size(n)
+			local bytes = {}
+			repeat
+				local byte = n % 128
+				n = math.floor(n / 128)
+				if n > 0 then byte = byte + 128 end
+				table.insert(bytes, string.char(byte))
+			until n == 0
+			return table.concat(bytes)
+		end
+
+		local function encode(value)
 			local tp = std.type(value)
 			if tp == 'string' then
-				return escape_str(value)
+				return 's' .. size(#value) .. value
 			elseif tp == 'number' then
-				return tostring(value)
+				if value == math.floor(value) and math.abs(value) < 2 ^ 53 and (value ~= 0 or 1 / value > 0) then
+					return 'i' .. size(value >= 0 and value * 2 or -value * 2 - 1)
+				end
+				local text = string.format('%.17g', value)
+				return 'd' .. size(#text) .. text
 			elseif tp == 'boolean' then
-				return value and 'true' or 'false'
+				return value and 't' or 'f'
 			elseif tp == 'array' then
-				local text = 'std::vector<Value>({'
+				local parts = { 'a' .. size(#value) }
 				for i = 1, #value do
-					text = text .. value_to_cpp(value[i]) .. ','
+					table.insert(parts, encode(value[i]))
 				end
-				text = text .. '})'
-				return text
+				return table.concat(parts)
 			elseif tp == 'object' then
-				local text = 'std::map<std::string, Value>({'
+				local parts = {}
 				for k, v in pairs(value) do
-					text = text .. '{' .. escape_str(std.str(k)) .. ', ' .. value_to_cpp(v) .. '},'
+					local key = std.str(k)
+					table.insert(parts, size(#key) .. key .. encode(v))
 				end
-				text = text .. '})'
-				return text
+				return 'o' .. size(#parts) .. table.concat(parts)
 			end
 
-			return 'Value()' --nil
+			return 'n' --nil
 		end
 
-		text = text .. '};\n\nconst std::vector<Value> CONSTANTS = {\n\tNull(),\n'
-		for i = 1, #bytecode[#bytecode] do
-			local value = bytecode[#bytecode][i]
-			text = text .. '\t' .. value_to_cpp(value) .. ',\n'
+		local function c_string(bytes)
+			return '"' .. bytes:gsub('[^%w _.,:;+*/=<>()%[%]{}!#%%&|^~@$-]', function(c)
+				return string.format('\\%03o', c:byte())
+			end) .. '"'
 		end
 
-		text = text .. '};\n\nconst bool SANDBOXED = ' .. (SANDBOX and 'true' or 'false') .. ';\n'
+		local constants, offsets, offset = {}, {}, 0
+		for i = 0, #bytecode[#bytecode] do
+			local data = i == 0 and 'n' or encode(bytecode[#bytecode][i])
+			table.insert(constants, '\t' .. c_string(data) .. '\n')
+			table.insert(offsets, offset)
+			offset = offset + #data
+		end
+
+		text = text .. '};\n\nconst char CONSTANT_DATA[] =\n' .. table.concat(constants) .. ';\n\n'
+		text = text .. 'const uint32_t CONSTANT_OFFSETS[] = {' .. table.concat(offsets, ', ') .. '};\n'
+		text = text .. 'const size_t CONSTANT_COUNT = ' .. #offsets .. ';\n\n'
+		text = text .. 'const bool SANDBOXED = ' .. (SANDBOX and 'true' or 'false') .. ';\n'
 		---@diagnostic disable-next-line
-		text = text .. 'const std::string VERSION = ' .. escape_str(VERSION or 'unknown') .. ';\n'
+		text = text .. 'const std::string VERSION = ' .. escape_str(VERSION or 'unknown') .. ';\n\n'
+		text = text .. native_text
 
 		return text;
 	end,
 
+	--- Rewrite generic Paisley bytecode into the C++ runtime's instruction set.
+	--- The constant lookup table (last element) is passed through unchanged.
+	--- @param bytecode table Paisley bytecode.
+	--- @return table bytecode The lowered bytecode.
+	lower = function(bytecode)
+		--Jumps are emitted as calls to builtin functions, but the C++ runtime
+		--can branch on them directly without going through the function call machinery.
+		local native_jumps = {
+			[CALL_CODES.jump] = OP.jump,
+			[CALL_CODES.jumpiffalse] = OP.jumpiffalse,
+			[CALL_CODES.jumpifnil] = OP.jumpifnil,
+		}
+
+		local result = {}
+		for i = 1, #bytecode - 1 do
+			local instr = bytecode[i]
+
+			--A jump with no target pops it from the stack, so leave that as a function call.
+			if instr[1] == OP.call and native_jumps[instr[3]] and instr[4] ~= nil then
+				instr = { native_jumps[instr[3]], instr[2], instr[4] }
+			end
+
+			table.insert(result, instr)
+		end
+
+		result = STANDALONE.cpp.iterate_loops(result)
+		result = STANDALONE.cpp.fuse(result)
+
+		table.insert(result, bytecode[#bytecode])
+		return result
+	end,
+
+	--- Turn loops over exploded arrays into loops over an iterator.
+	--- Loops are emitted as `call explode; L: jumpifnil E; ...; jump L; E: pop_until_null` (or `pop`),
+	--- which pushes every element before the first pass and leaves the ones not reached by `break` to be popped.
+	--- An iterator keeps just the array and a cursor on the stack instead. Once the loop is done it pops
+	--- itself, so the stack at E looks the same as it would after exploding.
+	--- Instructions are replaced one for one, so no jump targets change.
+	--- @param instructions table Lowered instructions, without the constant lookup table.
+	--- @return table instructions The instructions with loops rewritten.
+	iterate_loops = function(instructions)
+		for i = 1, #instructions - 1 do
+			local explode, test = instructions[i], instructions[i + 1]
+			if explode[1] == OP.call and explode[3] == CALL_CODES.explode and explode[4] == nil and
+				test[1] == OP.jumpifnil then
+				--Jump targets are 0-based, so the loop end is at index target + 1, just after the jump back to the test.
+				--Other code that explodes an array (such as reduce) doesn't loop back to the first test like this.
+				local back, finish = instructions[test[3]], instructions[test[3] + 1]
+				if back and back[1] == OP.jump and back[3] == i and finish and
+					(finish[1] == OP.pop or finish[1] == OP.pop_until_null and (tonumber(finish[3]) or 0) == 0) then
+					instructions[i] = { OP.iter_begin, explode[2] }
+					instructions[i + 1] = { OP.iter_next, test[2], test[3] }
+				end
+			end
+		end
+		return instructions
+	end,
+
+	--- Fuse common pairs of instructions into single superinstructions,
+	--- so that hot loops spend less time in dispatch and pushing intermediate values.
+	--- Since this removes instructions, all jump targets are remapped to match.
+	--- @param instructions table Lowered instructions, without the constant lookup table.
+	--- @return table instructions The instructions with superinstructions fused.
+	fuse = function(instructions)
+		--Operand holding the jump target, for each instruction that has one.
+		local target_operand = {
+			[OP.jump] = 3,
+			[OP.jumpiffalse] = 3,
+			[OP.jumpifnil] = 3,
+			[OP.get_cache_else_jump] = 4,
+			[OP.push_catch_loc] = 3,
+			[OP.pop_jump_if_false] = 3,
+			[OP.jump_if_nil_set] = 3,
+			[OP.iter_next] = 3,
+			[OP.iter_next_set] = 3,
+		}
+
+		local is_target = {}
+		for i = 1, #instructions do
+			local instr = instructions[i]
+
+			--Dynamic calls jump through a lookup table of label indices, which is stored as a constant.
+			--Don't rearrange programs that have them.
+			if instr[1] == OP.call and instr[3] == CALL_CODES.jump and instr[4] == nil then
+				return instructions
+			end
+
+			local ix = target_operand[instr[1]]
+			if ix and instr[ix] ~= nil then
+				is_target[instr[ix]] = true
+			end
+
+			--`jumpiffalse` may be fused so that it jumps past the `pop` at its target.
+			if instr[1] == OP.jumpiffalse and instr[3] ~= nil then
+				is_target[instr[3] + 1] = true
+			end
+		end
+
+		local function_names = {}
+		for name, code in pairs(CALL_CODES) do
+			function_names[code] = name
+		end
+
+		--Only functions that take a params array can be fused with their implode.
+		--"bool" is also an operator, so it never gets its own implode.
+		local function takes_params(code)
+			local name = function_names[code]
+			return name ~= nil and name ~= 'bool' and BUILTIN_FUNCS[name] ~= nil
+		end
+
+		--A call that never jumps, and doesn't use its second operand.
+		local function plain_call(instr)
+			return instr[1] == OP.call and instr[4] == nil and instr[3] ~= CALL_CODES.jump and
+				instr[3] ~= CALL_CODES.jumpiffalse and instr[3] ~= CALL_CODES.jumpifnil
+		end
+
+		--Pairs of instructions that can be fused, roughly in order of how often they run.
+		--The list comes from profiling the examples and tests with a PAISLEY_PROFILE build
+		--of the C++ runtime, keeping only the pairs that fit into one instruction's operands.
+		--Each rule returns the fused instruction, or nil if the pair doesn't match.
+		local rules = {
+			--get x; push c
+			function(a, b)
+				if a[1] == OP.get and b[1] == OP.push then
+					return { OP.get_push, a[2], a[3], b[3] }
+				end
+			end,
+			--get x; get y
+			function(a, b)
+				if a[1] == OP.get and b[1] == OP.get then
+					return { OP.get_get, a[2], a[3], b[3] }
+				end
+			end,
+			--set x; get y
+			function(a, b)
+				if a[1] == OP.set and b[1] == OP.get then
+					return { OP.set_get, a[2], a[3], b[3] }
+				end
+			end,
+			--call F; set x
+			function(a, b)
+				if plain_call(a) and b[1] == OP.set then
+					return { OP.call_set, a[2], a[3], b[3] }
+				end
+			end,
+			--jumpiffalse L; pop, when L is also a pop.
+			--Both branches drop the condition, so pop it first and then skip the pop at L.
+			function(a, b)
+				if a[1] == OP.jumpiffalse and b[1] == OP.pop and a[3] ~= nil then
+					local target = instructions[a[3] + 1]
+					if target and target[1] == OP.pop then
+						return { OP.pop_jump_if_false, a[2], a[3] + 1 }
+					end
+				end
+			end,
+			--jumpifnil L; set x
+			function(a, b)
+				if a[1] == OP.jumpifnil and b[1] == OP.set and a[3] ~= nil then
+					return { OP.jump_if_nil_set, a[2], a[3], b[3] }
+				end
+			end,
+			--iter_next L; set x
+			function(a, b)
+				if a[1] == OP.iter_next and b[1] == OP.set then
+					return { OP.iter_next_set, a[2], a[3], b[3] }
+				end
+			end,
+			--call arrayslice; call arrayindex
+			--Slicing a string or array copies the slice in one go, instead of building an array of indices.
+			function(a, b)
+				if plain_call(a) and a[3] == CALL_CODES.arrayslice and plain_call(b) and b[3] == CALL_CODES.arrayindex then
+					return { OP.slice, a[2] }
+				end
+			end,
+			--push c; get x
+			function(a, b)
+				if a[1] == OP.push and b[1] == OP.get then
+					return { OP.push_get, a[2], a[3], b[3] }
+				end
+			end,
+			--push c; push d
+			function(a, b)
+				if a[1] == OP.push and b[1] == OP.push then
+					return { OP.push_push, a[2], a[3], b[3] }
+				end
+			end,
+			--implode N; call F
+			--Builtin functions called this way read their arguments straight off the stack,
+			--instead of the runtime building an array of them first.
+			function(a, b)
+				if a[1] == OP.call and a[3] == CALL_CODES.implode and b[1] == OP.call and takes_params(b[3]) then
+					return { OP.call_args, b[2], b[3], a[4] or 0 }
+				end
+			end,
+		}
+
+		local result = {}
+		local new_index = {}
+		local i = 1
+		while i <= #instructions do
+			local instr = instructions[i]
+			local next_instr = instructions[i + 1]
+			new_index[i - 1] = #result
+
+			--Instruction indices are 0-based at run time, so the second instruction is at index i.
+			local fused = nil
+			if next_instr and not is_target[i] then
+				for _, rule in ipairs(rules) do
+					fused = rule(instr, next_instr)
+					if fused then break end
+				end
+			end
+
+			if fused then
+				table.insert(result, fused)
+				new_index[i] = #result - 1
+				i = i + 2
+			else
+				table.insert(result, instr)
+				i = i + 1
+			end
+		end
+		new_index[#instructions] = #result
+
+		for k, instr in ipairs(result) do
+			local ix = target_operand[instr[1]]
+			if ix and instr[ix] ~= nil then
+				result[k] = { instr[1], instr[2], instr[3], instr[4] }
+				result[k][ix] = new_index[instr[ix]]
+			end
+		end
+
+		return result
+	end,
+
+	--- Translate lowered bytecode into a C++ function, so that the program runs as native code
+	--- instead of being interpreted. Builtin calls become direct calls, jumps become `goto`s,
+	--- and constants are pushed as literals where possible, so the C++ compiler can optimise across instructions.
+	--- Control flow that is only known at run time (subroutine returns, exceptions and dynamic calls)
+	--- goes through a jump table of the instructions that it can land on.
+	--- @param bytecode table Lowered bytecode, including the constant lookup table.
+	--- @return string includes The headers needed by the generated code.
+	--- @return string program_text The generated C++ function.
+	native = function(bytecode)
+		local constants = bytecode[#bytecode]
+		local count = #bytecode - 1
+
+		local function_names = {}
+		for name, code in pairs(CALL_CODES) do
+			function_names[code] = name
+		end
+
+		--Builtin functions whose names are C++ keywords have an underscore in front.
+		local keywords = { bool = true, char = true, delete = true, union = true }
+		local used_functions = {}
+		local function builtin(code)
+			local name = function_names[code]
+			used_functions[name] = true
+			return keywords[name] and ('_' .. name) or name
+		end
+
+		--Jumps that are still calls take their target from the stack, so they can go anywhere.
+		local function is_dynamic_jump(instr)
+			return instr[1] == OP.call and
+				(instr[3] == CALL_CODES.jump or instr[3] == CALL_CODES.jumpiffalse or instr[3] == CALL_CODES.jumpifnil)
+		end
+
+		--Numbers, booleans and null become literals. Everything else is copied from the constant table.
+		local function literal(id)
+			local value = constants[id]
+			if id == nil or id == 0 or value == nil then
+				return 'Value()'
+			elseif type(value) == 'boolean' then
+				return value and 'Value(true)' or 'Value(false)'
+			elseif type(value) == 'number' and value == value and value ~= math.huge and value ~= -math.huge then
+				local text = string.format('%.17g', value)
+				if not text:find('[%.e]') then text = text .. '.0' end
+				return 'Value(' .. text .. ')'
+			end
+			return 'vm.const_lookup[' .. id .. ']'
+		end
+
+		--Instructions with no direct C++ equivalent call the interpreter's action for them.
+		local actions = {
+			[OP.run_command] = 'run_command',
+			[OP.push_cmd_result] = 'push_cmd_result',
+			[OP.push_index] = 'push_index',
+			[OP.pop_goto_index] = 'pop_goto_index',
+			[OP.copy] = 'copy',
+			[OP.delete_var] = 'delete_var',
+			[OP.swap] = 'swap',
+			[OP.pop_until_null] = 'pop_until_null',
+			[OP.set_cache] = 'set_cache',
+			[OP.delete_cache] = 'delete_cache',
+			[OP.push_catch_loc] = 'push_catch_loc',
+			[OP.variable_insert] = 'variable_insert',
+			[OP.destructure] = 'destructure',
+			[OP.get_exception_type] = 'get_exception_type',
+			[OP.slice] = 'slice',
+			[OP.push_exception] = 'push_exception',
+			[OP.throw_exception] = 'throw_exception',
+		}
+
+		--Actions that may move to an instruction that isn't known until run time.
+		local indirect = {
+			[OP.run_command] = true,
+			[OP.pop_goto_index] = true,
+			[OP.throw_exception] = true,
+		}
+
+		--Operand holding the jump target, for each instruction that jumps to a fixed location.
+		local target_operand = {
+			[OP.jump] = 3,
+			[OP.jumpiffalse] = 3,
+			[OP.jumpifnil] = 3,
+			[OP.get_cache_else_jump] = 4,
+			[OP.pop_jump_if_false] = 3,
+			[OP.jump_if_nil_set] = 3,
+			[OP.iter_next] = 3,
+			[OP.iter_next_set] = 3,
+		}
+
+		--Find every instruction that needs a label, either because something jumps straight to it,
+		--or because it's in the jump table.
+		local labels = {}
+		local use_jump_table = false
+		for i = 1, count do
+			local instr = bytecode[i]
+			local ix = target_operand[instr[1]]
+			if ix then labels[instr[ix]] = true end
+			if indirect[instr[1]] or is_dynamic_jump(instr) then use_jump_table = true end
+		end
+
+		local jump_table = {}
+		if use_jump_table then
+			for i = 1, count do
+				local instr = bytecode[i]
+				if is_dynamic_jump(instr) then
+					for k = 0, count do jump_table[k] = true end
+					break
+				elseif instr[1] == OP.push_index then
+					--Subroutines return to just after the jump that follows push_index.
+					jump_table[i + 1] = true
+				elseif instr[1] == OP.push_catch_loc then
+					jump_table[instr[3]] = true
+				end
+			end
+		end
+
+		local lines = {}
+		local function emit(line)
+			table.insert(lines, '\t' .. line)
+		end
+
+		for i = 1, count do
+			local instr = bytecode[i]
+			local op, a, b = instr[1], instr[3], instr[4]
+
+			--Instruction indices are 0-based at run time.
+			local index = i - 1
+			local function slot(operand)
+				return 'code[' .. index .. '].operand' .. operand
+			end
+			local function at()
+				emit('vm.instruction_index = ' .. index .. ';')
+			end
+
+			if labels[index] or jump_table[index] then
+				table.insert(lines, 'L' .. index .. ':')
+			end
+
+			if op == OP.call then
+				at()
+				emit('call_builtin(vm, ' .. builtin(a) .. ', -1, ' .. (b or 0) .. ');')
+				if is_dynamic_jump(instr) then
+					emit('if (vm.instruction_index != ' .. index .. ') goto dispatch;')
+				end
+			elseif op == OP.call_args then
+				at()
+				emit('call_builtin_args(vm, ' .. builtin(a) .. ', ' .. (b or 0) .. ');')
+			elseif op == OP.call_set then
+				at()
+				emit('call_builtin(vm, ' .. builtin(a) .. ', -1, 0);')
+				emit('vm.variables.set(' .. slot(1) .. ', vm.stack.pop());')
+			elseif op == OP.get then
+				emit('push_variable(vm, ' .. slot(1) .. ');')
+			elseif op == OP.set then
+				emit('vm.variables.set(' .. slot(1) .. ', vm.stack.pop());')
+			elseif op == OP.push then
+				emit('vm.stack.push(' .. literal(a) .. ');')
+			elseif op == OP.pop then
+				emit('vm.stack.pop();')
+			elseif op == OP.get_get then
+				emit('push_variable(vm, ' .. slot(0) .. ');')
+				emit('push_variable(vm, ' .. slot(1) .. ');')
+			elseif op == OP.get_push then
+				emit('push_variable(vm, ' .. slot(0) .. ');')
+				emit('vm.stack.push(' .. literal(b) .. ');')
+			elseif op == OP.push_get then
+				emit('vm.stack.push(' .. literal(a) .. ');')
+				emit('push_variable(vm, ' .. slot(1) .. ');')
+			elseif op == OP.push_push then
+				emit('vm.stack.push(' .. literal(a) .. ');')
+				emit('vm.stack.push(' .. literal(b) .. ');')
+			elseif op == OP.set_get then
+				emit('vm.variables.set(' .. slot(0) .. ', vm.stack.pop());')
+				emit('push_variable(vm, ' .. slot(1) .. ');')
+			elseif op == OP.jump then
+				emit('goto L' .. a .. ';')
+			elseif op == OP.jumpiffalse then
+				emit('if (!vm.stack.back().to_bool()) goto L' .. a .. ';')
+			elseif op == OP.jumpifnil then
+				emit('if (vm.stack.back().is_null()) goto L' .. a .. ';')
+			elseif op == OP.pop_jump_if_false then
+				emit('if (!vm.stack.pop().to_bool()) goto L' .. a .. ';')
+			elseif op == OP.jump_if_nil_set then
+				emit('if (vm.stack.back().is_null()) goto L' .. a .. ';')
+				emit('vm.variables.set(' .. slot(1) .. ', vm.stack.pop());')
+			elseif op == OP.iter_begin then
+				emit('iter_begin(vm);')
+			elseif op == OP.iter_next then
+				emit('if (Value value; iterate(vm, value)) vm.stack.push_back(std::move(value)); else goto L' .. a .. ';')
+			elseif op == OP.iter_next_set then
+				emit('if (Value value; iterate(vm, value)) vm.variables.set(' .. slot(1) .. ', std::move(value)); else goto L' .. a .. ';')
+			elseif op == OP.get_cache_else_jump then
+				at()
+				emit('get_cache_else_jump(vm);')
+				emit('if (vm.instruction_index != ' .. index .. ') goto L' .. b .. ';')
+			elseif actions[op] then
+				at()
+				emit(actions[op] .. '(vm);')
+				if indirect[op] then
+					emit('if (vm.instruction_index != ' .. index .. ') goto dispatch;')
+				end
+			else
+				at()
+				emit('vm.error("Invalid opcode: ' .. tostring(op) .. '");')
+			end
+		end
+
+		if labels[count] or jump_table[count] then
+			table.insert(lines, 'L' .. count .. ':')
+		end
+		emit('return;')
+
+		if use_jump_table then
+			table.insert(lines, '')
+			table.insert(lines, 'dispatch:')
+			emit('switch (++vm.instruction_index)')
+			emit('{')
+			for index = 0, count do
+				if jump_table[index] then
+					emit('case ' .. index .. ':')
+					emit('\tgoto L' .. index .. ';')
+				end
+			end
+			emit('default:')
+			emit('\treturn;')
+			emit('}')
+		end
+
+		local body = table.concat(lines, '\n')
+
+		local text = 'static void native_program(VirtualMachine &vm) noexcept\n{\n'
+		if body:find('code[', 1, true) then
+			--Variable slots are only known once the program is loaded.
+			text = text .. '\tconst Instruction *code = vm.instructions.data();\n\n'
+		elseif count == 0 then
+			text = text .. '\t(void)vm;\n'
+		end
+		text = text .. body .. '\n}\n\nvoid (*const NATIVE_PROGRAM)(VirtualMachine &) = native_program;\n'
+
+		local includes = '#include "native.hpp"\n'
+		local names = {}
+		for name in pairs(used_functions) do table.insert(names, name) end
+		table.sort(names)
+		for _, name in ipairs(names) do
+			includes = includes .. '#include "functions/' .. name .. '.hpp"\n'
+		end
+
+		return includes, text
+	end,
+
 	--- Compile a standalone C++ program into a binary executable.
 	--- @param program_text string The C++ program text.
 	--- @param output_file string The output file path.
@@ -280,7 +280,11 @@ return {
 			arg_error('Introspection flags can only be used with `--introspect`.')
 		end
 
-		if flags.target then flags.standalone = true end
+		if flags.cpp_native and flags.target and flags.target ~= 'cpp' then
+			arg_error('The `--cpp-native` flag can only be used with the `cpp` target.')
+		end
+
+		if flags.target or flags.cpp_native then flags.standalone = true end
 
 		if flags.standalone and not flags.output then
 			arg_error('Must specify an output file with `--output` when building standalone applications.')
@@ -0,0 +1,170 @@
+--Commands started in the background with cmd_spawn(), keyed by their handle.
+--Lua can only read one stream from a process, so each command's stderr goes to a temp file.
+--Output is only read when a command is waited on, so commands are collected in the order they're waited on.
+
+local jobs = {}
+local running = {}
+local next_handle = 1
+
+local function quote(args)
+	local text = ''
+	for i = 1, #args do
+		local arg = std.str(args[i]):gsub('\\', '\\\\'):gsub('"', '\\"'):gsub('%$', '\\$'):gsub('`', '\\`')
+		--Escape strings correctly in powershell
+		if package.config:sub(1, 1) == '\\' then arg = arg:gsub('\\"', '`"') end
+		text = text .. '"' .. arg .. '" '
+	end
+	return text
+end
+
+--Read a command's stdout and its stderr file, and wait for it to exit.
+local function collect(pipe, err_file)
+	local out = pipe:read('*a')
+	local _, how, code = pipe:close()
+
+	local err = ''
+	local file = io.open(err_file, 'r')
+	if file then
+		err = file:read('*a')
+		file:close()
+	end
+	os.remove(err_file)
+
+	local result = std.object()
+	result.status = (how == 'signal' and 128 or 0) + (code or 0)
+	result.stdout = out
+	result.stderr = err
+	return result
+end
+
+local cores
+
+local proc
+
+proc = {
+	--- Get the number of CPU cores, which is the default limit on how many commands run at once.
+	--- @return number
+	cores = function()
+		if not cores then
+			local pipe = io.popen('nproc 2>/dev/null', 'r')
+			cores = pipe and tonumber(pipe:read('*l')) or 4
+			if pipe then pipe:close() end
+		end
+		return cores
+	end,
+
+	--- Read a command's output and wait for it to exit.
+	--- @param handle number
+	finish = function(handle)
+		local job = jobs[handle]
+		if job.result then return end
+
+		job.result = collect(job.pipe, job.err_file)
+
+		for i = 1, #running do
+			if running[i] == handle then
+				table.remove(running, i)
+				break
+			end
+		end
+	end,
+
+	--- Start a command in the background.
+	--- @param command any A string to run in the shell, or an array of the program and its arguments.
+	--- @param max_running number If this many commands are already running, finish the oldest one first.
+	--- @return number handle
+	spawn = function(command, max_running)
+		while #running > 0 and #running >= max_running do
+			proc.finish(running[1])
+		end
+
+		local text = std.type(command) == 'string' and command or quote(command)
+		local err_file = os.tmpname()
+		local handle = next_handle
+		next_handle = next_handle + 1
+
+		jobs[handle] = {
+			pipe = io.popen('{ ' .. text .. '; } 2>' .. err_file, 'r'),
+			err_file = err_file,
+		}
+		table.insert(running, handle)
+		return handle
+	end,
+
+	--- Run a command to completion, and get the lines of its stdout.
+	--- @param command any A string to run in the shell, or an array of the program and its arguments.
+	--- @return table lines
+	lines = function(command)
+		local result = std.array()
+		local pipe = io.popen(std.type(command) == 'string' and command or quote(command), 'r')
+		if pipe then
+			for line in pipe:lines() do
+				table.insert(result, line)
+			end
+			pipe:close()
+		end
+		return result
+	end,
+
+	--- Run commands in a pipeline, and get the result of the last one.
+	--- @param commands table Each command is a string to run in the shell, or an array of the program and its arguments.
+	--- @param input any Text for the first command's stdin (an array is one line per element), or nil.
+	--- @return table result An object with "status", "stdout" and "stderr" keys.
+	pipe = function(commands, input)
+		local texts = {}
+		for i = 1, #commands do
+			local command = commands[i]
+			texts[i] = std.type(command) == 'string' and ('{ ' .. command .. '; }') or quote(command)
+		end
+		local text = '{ ' .. table.concat(texts, ' | ') .. '; }'
+
+		local in_file
+		if input ~= nil then
+			in_file = os.tmpname()
+			local file = io.open(in_file, 'w')
+			if file then
+				if std.type(input) == 'array' then
+					for i = 1, #input do file:write(std.str(input[i]), '\n') end
+				else
+					file:write(std.str(input))
+				end
+				file:close()
+			end
+			text = text .. ' <' .. in_file
+		end
+
+		local err_file = os.tmpname()
+		local result = collect(io.popen(text .. ' 2>' .. err_file, 'r'), err_file)
+		if in_file then os.remove(in_file) end
+		return result
+	end,
+
+	--- Wait for a command to finish, and take its result.
+	--- @param handle number
+	--- @return table|nil result An object with "status", "stdout" and "stderr" keys, or nil if the handle is not valid.
+	await = function(handle)
+		if not jobs[handle] then return nil end
+		proc.finish(handle)
+		local result = jobs[handle].result
+		jobs[handle] = nil
+		return result
+	end,
+
+	--- Wait until any of the given commands has finished.
+	--- @param handles table
+	--- @return number|nil handle The handle of a finished command, or nil if none of the handles are valid.
+	await_any = function(handles)
+		for i = 1, #handles do
+			local job = jobs[handles[i]]
+			if job and job.result then return handles[i] end
+		end
+		for i = 1, #handles do
+			if jobs[handles[i]] then
+				proc.finish(handles[i])
+				return handles[i]
+			end
+		end
+	end,
+}
+
+return proc